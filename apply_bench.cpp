@@ -0,0 +1,89 @@
+//
+//File      : apply_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//cost of an apply with and without reading the configuration, on the same histograms: the image filled once is what
+//a header generated by iwir codegen hands over, so that the second figure is the apply cost with parsing removed
+//usage: iwir-apply-bench <config> <root_file> <hist_1;hist_2;...> [repetition_count]
+
+
+#include "configurator.hpp"
+#include "root_context.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "TFile.h"
+#include "TH1.h"
+#include "TROOT.h"
+
+namespace {
+
+    template<class Apply>
+    double measure( unsigned repetition_count_p, Apply apply_p ) {
+        auto const start = std::chrono::steady_clock::now();
+        for( unsigned i{0} ; i < repetition_count_p ; ++i ){
+            auto * canvas_h = apply_p();
+            if( !canvas_h ){ return -1; }
+            delete canvas_h;
+        }
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / repetition_count_p * 1e6;
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    if( argc < 4 ){
+        std::cerr << "usage: iwir-apply-bench <config> <root_file> <hist_1;hist_2;...> [repetition_count]\n";
+        return 1;
+    }
+    std::string const config_file{ argv[1] };
+    unsigned const repetition_count = argc > 4 ? std::strtoul( argv[4], nullptr, 10 ) : 1000;
+    if( !repetition_count ){ return 1; }
+
+    auto file_h = iwir::open_private( argv[2] );
+    if( !file_h ){
+        std::cerr << "Could not open file: " << argv[2] << "\n";
+        return 1;
+    }
+
+    gROOT->SetBatch( true );
+
+    //read once for both: only the configuration differs between the two figures
+    std::vector<TH1D*> hist_c;
+    for( auto const& name : iwir::regex_split( argv[3], std::regex{"[^;]+"} ) ){
+        auto * hist_h = dynamic_cast<TH1D*>( file_h->Get( name.c_str() ) );
+        if( !hist_h ){
+            std::cerr << "Could not find histogram " << name << " in " << argv[2] << "\n";
+            return 1;
+        }
+        hist_h->SetDirectory( nullptr );
+        hist_c.push_back( hist_h );
+    }
+
+    auto const parsed = measure( repetition_count, [&config_file, &hist_c](){
+        auto applier = iwir::configurator{}.prepare( config_file );
+        return applier ? applier( std::vector<TH1D*>{ hist_c } ) : nullptr;
+    } );
+
+    auto const applier = iwir::configurator{}.prepare( config_file );
+    if( !applier || parsed < 0 ){ return 1; }
+    auto const filled = measure( repetition_count, [&applier, &hist_c](){ return applier( std::vector<TH1D*>{ hist_c } ); } );
+
+    std::cout << "read, filled and applied: " << parsed << " us per apply\n"
+              << "applied from a filled image: " << filled << " us per apply\n"
+              << "parsing: " << parsed - filled << " us per apply (" << ( parsed > 0 ? 100 * ( parsed - filled ) / parsed : 0. ) << "%)\n";
+
+    for( auto * hist_h : hist_c ){ delete hist_h; }
+    return 0;
+}
@@ -0,0 +1,146 @@
+//
+//File      : arena.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef arena_h
+#define arena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace iwir { struct monotonic_arena; }
+
+namespace details {
+    inline iwir::monotonic_arena*& current_arena() {
+        static thread_local iwir::monotonic_arena* current_h = nullptr;
+        return current_h;
+    }
+} //namespace details
+
+namespace iwir {
+
+    //------------------------------monotonic_arena----------------------------------------
+
+    //bump allocator: memory is only given back in one shot, through release() or destruction
+    struct monotonic_arena {
+        explicit monotonic_arena( std::size_t block_size_p = 64 * 1024 ) : block_size_m{block_size_p} {}
+
+        monotonic_arena( monotonic_arena const& ) = delete;
+        monotonic_arena& operator=( monotonic_arena const& ) = delete;
+
+        ~monotonic_arena(){ release(); }
+
+        void* allocate( std::size_t size_p, std::size_t alignment_p ) {
+            auto position = (current_m + alignment_p - 1) & ~(alignment_p - 1);
+            if( position + size_p > end_m ){
+                add_block( size_p + alignment_p );
+                position = (current_m + alignment_p - 1) & ~(alignment_p - 1);
+            }
+            current_m = position + size_p;
+            return reinterpret_cast<void*>( position );
+        }
+
+        void release() {
+            for( auto * block_h : block_c ){ ::operator delete( block_h ); }
+            block_c.clear();
+            current_m = 0;
+            end_m = 0;
+        }
+
+    private:
+        void add_block( std::size_t minimum_size_p ) {
+            auto size = minimum_size_p > block_size_m ? minimum_size_p : block_size_m;
+            auto * block_h = ::operator new( size );
+            block_c.push_back( block_h );
+            current_m = reinterpret_cast<std::uintptr_t>( block_h );
+            end_m = current_m + size;
+        }
+
+    private:
+        std::size_t block_size_m;
+        std::uintptr_t current_m{0};
+        std::uintptr_t end_m{0};
+        std::vector<void*> block_c;
+    };
+
+
+    //------------------------------arena_scope----------------------------------------
+
+    //binds an arena to the current thread: every image storage created while it lives comes from it
+    struct arena_scope {
+        explicit arena_scope( monotonic_arena& arena_p ) : previous_mh{ details::current_arena() } {
+            details::current_arena() = &arena_p;
+        }
+        ~arena_scope(){ details::current_arena() = previous_mh; }
+
+        arena_scope( arena_scope const& ) = delete;
+        arena_scope& operator=( arena_scope const& ) = delete;
+
+    private:
+        monotonic_arena* previous_mh;
+    };
+
+
+    //binds the free store back, for storage that has to outlive an arena bound further up
+    struct free_store_scope {
+        free_store_scope() : previous_mh{ details::current_arena() } { details::current_arena() = nullptr; }
+        ~free_store_scope(){ details::current_arena() = previous_mh; }
+
+        free_store_scope( free_store_scope const& ) = delete;
+        free_store_scope& operator=( free_store_scope const& ) = delete;
+
+    private:
+        monotonic_arena* previous_mh;
+    };
+
+
+    //------------------------------arena_allocator----------------------------------------
+
+    //falls back on the free store when no arena is bound
+    template<class T>
+    struct arena_allocator {
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        template<class U> friend struct arena_allocator;
+
+        arena_allocator() : arena_mh{ details::current_arena() } {}
+        template<class U>
+        arena_allocator( arena_allocator<U> const& other_p ) : arena_mh{ other_p.arena_mh } {}
+
+        T* allocate( std::size_t n_p ) {
+            if( !arena_mh ){ return static_cast<T*>( ::operator new( n_p * sizeof(T) ) ); }
+            return static_cast<T*>( arena_mh->allocate( n_p * sizeof(T), alignof(T) ) );
+        }
+        void deallocate( T* t_ph, std::size_t ) {
+            if( !arena_mh ){ ::operator delete( t_ph ); }
+        }
+
+        //copied storage follows the arena bound when the copy is made, not the one of the source
+        arena_allocator select_on_container_copy_construction() const { return {}; }
+
+        template<class U>
+        bool operator==( arena_allocator<U> const& other_p ) const { return arena_mh == other_p.arena_mh; }
+        template<class U>
+        bool operator!=( arena_allocator<U> const& other_p ) const { return arena_mh != other_p.arena_mh; }
+
+    private:
+        monotonic_arena* arena_mh;
+    };
+
+
+    template<class T>
+    using arena_vector = std::vector<T, arena_allocator<T>>;
+    using arena_string = std::basic_string<char, std::char_traits<char>, arena_allocator<char>>;
+
+} //namespace iwir
+
+#endif /* arena_h */
@@ -0,0 +1,222 @@
+//
+//File      : async_apply.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "async_apply.hpp"
+#include "configurator.hpp"
+#include "key_index.hpp"
+#include "root_context.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TROOT.h"
+
+namespace iwir {
+
+    namespace {
+        struct loaded {
+            configurator::applier applier;
+            std::vector<TH1D*> hist_c;
+            //read from the files by the worker, deleted unless a canvas takes them over
+            std::vector< std::unique_ptr<TH1D> > read_c;
+        };
+
+        //what the worker needs to find the histograms, captured on the calling thread
+        struct request {
+            std::string config_file;
+            std::vector<std::string> name_c;
+            std::vector<TH1D*> in_memory_c;
+            std::vector<std::string> file_c;
+        };
+
+        struct async_worker {
+            async_worker() {
+                ROOT::EnableThreadSafety();
+                hold_across_fork( mutex_m );
+                std::thread{ [this](){ run(); } }.detach();
+            }
+
+            std::future<loaded> push( request request_p ) {
+                auto task_h = std::make_shared< std::packaged_task<loaded()> >(
+                                        [this, request_p](){ return load( request_p ); } );
+                auto result = task_h->get_future();
+                {
+                    std::lock_guard<std::mutex> lock{ mutex_m };
+                    task_mc.emplace_back( [task_h](){ (*task_h)(); } );
+                }
+                condition_m.notify_one();
+                return result;
+            }
+
+        private:
+            void run() {
+                while( true ){
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock{ mutex_m };
+                        condition_m.wait( lock, [this](){ return !task_mc.empty(); } );
+                        task = std::move( task_mc.front() );
+                        task_mc.pop_front();
+                    }
+                    task();
+                }
+            }
+
+            //only ever called from the worker thread, hence the unguarded file cache
+            loaded load( request const& request_p ) {
+                loaded result{ configurator{}.prepare( request_p.config_file ), {}, {} };
+                if( !result.applier ){ return result; }
+
+                for( auto * hist_h : request_p.in_memory_c ){ result.hist_c.push_back( hist_h ); }
+                for( auto const& file_name : request_p.file_c ){
+                    auto * file_h = opened( file_name );
+                    if( !file_h ){ continue; }
+
+                    auto const index_h = key_index::of( file_h );
+                    for( auto const& name : request_p.name_c ){
+                        auto const * entry_h = index_h->resolve( name );
+                        if( !entry_h ){ continue; }
+                        auto * hist_h = dynamic_cast<TH1D*>( read_object( file_h, *entry_h ) );
+                        if( !hist_h ){ continue; }
+                        //the worker handle never leaves this thread: the canvas takes the histogram over
+                        hist_h->SetDirectory( nullptr );
+                        hist_h->SetBit( TObject::kCanDelete );
+                        result.hist_c.push_back( hist_h );
+                        result.read_c.emplace_back( hist_h );
+                    }
+                }
+                return result;
+            }
+
+            //reopened when the file changed on disk since, at most open_file_count kept open as batch_renderer does
+            TFile* opened( std::string const& file_name_p ) {
+                auto const stamp = stamp_of( file_name_p );
+                auto file_i = file_mc.find( file_name_p );
+                if( file_i != file_mc.end() ){
+                    if( file_i->second.file_h && file_i->second.stamp == stamp ){
+                        use_mc.splice( use_mc.begin(), use_mc, file_i->second.use_i );
+                        return file_i->second.file_h.get();
+                    }
+                    use_mc.erase( file_i->second.use_i );
+                    file_mc.erase( file_i );
+                }
+
+                if( file_mc.size() >= open_file_count ){
+                    file_mc.erase( use_mc.back() );
+                    use_mc.pop_back();
+                }
+
+                use_mc.push_front( file_name_p );
+                return file_mc.emplace( file_name_p, open_file{ open_private( file_name_p ), stamp, use_mc.begin() } )
+                              .first->second.file_h.get();
+            }
+
+        private:
+            std::mutex mutex_m;
+            std::condition_variable condition_m;
+            std::deque< std::function<void()> > task_mc;
+            struct open_file {
+                std::unique_ptr<TFile> file_h;
+                file_stamp stamp;
+                std::list<std::string>::iterator use_i;
+            };
+            static constexpr std::size_t open_file_count = 64;
+            std::unordered_map< std::string, open_file > file_mc;
+            //most recently used first
+            std::list<std::string> use_mc;
+        };
+
+        //never destroyed: its files must not be closed after ROOT has been torn down
+        async_worker& worker() {
+            static auto * worker_h = new async_worker{};
+            return *worker_h;
+        }
+    } //namespace
+
+
+    struct async_apply::state {
+        //never drawn: what the worker read is only deleted once it is done with it
+        ~state() {
+            if( !drawn && future.valid() ){
+                auto result = future.get();
+                //not held while waiting: the worker may need it to read
+                root_guard guard{ root_mutex() };
+                result.read_c.clear();
+            }
+        }
+
+        std::future<loaded> future;
+        TCanvas* canvas_h{nullptr};
+        bool drawn{false};
+    };
+
+    bool async_apply::ready() const {
+        if( !state_mh ){ return false; }
+        return state_mh->drawn ||
+               state_mh->future.wait_for( std::chrono::seconds{0} ) == std::future_status::ready;
+    }
+
+    TCanvas* async_apply::get() {
+        if( !state_mh ){ return nullptr; }
+        if( state_mh->drawn ){ return state_mh->canvas_h; }
+
+        auto result = state_mh->future.get();
+        state_mh->drawn = true;
+        if( result.applier ){ state_mh->canvas_h = result.applier( std::move(result.hist_c) ); }
+        //only those drawn are taken over by the canvas, histograms past the hist1d entries are left out of it
+        if( state_mh->canvas_h ){
+            auto const * primitive_ch = state_mh->canvas_h->GetListOfPrimitives();
+            for( auto& read_h : result.read_c ){
+                if( primitive_ch->FindObject( read_h.get() ) ){ read_h.release(); }
+            }
+        }
+        root_guard guard{ root_mutex() };
+        result.read_c.clear();
+        return state_mh->canvas_h;
+    }
+
+
+    async_apply apply_async( std::string const& config_file_p, std::string const& hist_list_p ) {
+        request current{ config_file_p, {}, {}, {} };
+
+        std::istringstream stream{ hist_list_p };
+        std::string name;
+        while( std::getline( stream, name, ';' ) ){ if( !name.empty() ){ current.name_c.push_back( name ); } }
+
+        //objects already in memory are taken as they are, files are only named: the worker opens its own handles
+        auto context = lookup_context::current();
+        root_guard guard{ root_mutex() };
+        if( context.directory_h ){
+            for( auto * object_h : *context.directory_h->GetList() ){
+                auto * hist_h = dynamic_cast<TH1D*>( object_h );
+                if( !hist_h ){ continue; }
+                for( auto const& name : current.name_c ){
+                    if( name == hist_h->GetName() ){ current.in_memory_c.push_back( hist_h ); break; }
+                }
+            }
+        }
+        for( auto * file_h : context.file_c ){ current.file_c.push_back( file_h->GetName() ); }
+
+        auto state_h = std::make_shared<async_apply::state>();
+        state_h->future = worker().push( std::move(current) );
+        return async_apply{ std::move(state_h) };
+    }
+
+} //namespace iwir
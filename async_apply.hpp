@@ -0,0 +1,47 @@
+//
+//File      : async_apply.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef async_apply_h
+#define async_apply_h
+
+//std headers
+#include <memory>
+#include <string>
+
+
+//ROOT header
+#include "TCanvas.h"
+
+
+namespace iwir {
+
+    //handle on a configuration being read, and on histograms being loaded, by the background worker
+    //only the drawing is left to the thread calling get(), which has to be the ROOT main thread
+    struct async_apply {
+        struct state;
+
+    public:
+        async_apply() = default;
+        explicit async_apply( std::shared_ptr<state> state_ph ) : state_mh{ std::move(state_ph) } {}
+
+        bool valid() const { return static_cast<bool>( state_mh ); }
+        //configuration and histograms are loaded, get() will only draw
+        bool ready() const;
+        //waits for the loading, draws on the first call and returns the same canvas afterwards (nullptr on failure)
+        TCanvas* get();
+
+    private:
+        std::shared_ptr<state> state_mh; //!
+    };
+
+    //queued to a single worker thread, which keeps its own handle on every file it reads from:
+    //requests are served in order, so that the next plot loads while the current one is drawn
+    async_apply apply_async( std::string const& config_file_p, std::string const& hist_list_p );
+
+} //namespace iwir
+
+#endif /* async_apply_h */
@@ -0,0 +1,161 @@
+//
+//File      : batch.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "batch.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "TROOT.h"
+
+namespace iwir {
+
+    std::vector<job> read_manifest( std::string const& manifest_file_p ) {
+        std::vector<job> result_c;
+
+        std::ifstream input{ manifest_file_p };
+        if( !input.is_open() ){
+            std::cerr << "Could not open manifest: " << manifest_file_p << "\n";
+            return result_c;
+        }
+
+        std::string line;
+        while( std::getline( input, line ) ){
+            if( line.empty() || line.front() == '#' ){ continue; }
+
+            std::istringstream stream{ line };
+            job current;
+            if( stream >> current.config >> current.file >> current.hist_list >> current.output ){
+                result_c.push_back( std::move(current) );
+            }
+            else{
+                std::cerr << "Malformed manifest line: " << line << "\n";
+            }
+        }
+
+        return result_c;
+    }
+
+    //-------------------------batch_renderer---------------------------------------------
+
+    batch_renderer::report batch_renderer::operator()( std::vector<job> const& job_pc ) {
+        report result;
+
+        auto was_batch = gROOT->IsBatch();
+        gROOT->SetBatch( true );
+
+        auto start = std::chrono::steady_clock::now();
+        for( auto const& job : job_pc ){
+            if( render( job ) ){ ++result.rendered; }
+            else{ result.failure_c.push_back( job.output ); }
+        }
+        result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        gROOT->SetBatch( was_batch );
+
+        std::cout << "rendered: " << result.rendered << " plots in " << result.seconds << "s ("
+                  << (result.seconds > 0 ? result.rendered / result.seconds : 0.) << " plots/s), "
+                  << result.failure_c.size() << " failures\n";
+        return result;
+    }
+
+    batch_renderer::report batch_renderer::plan( std::vector<job> const& job_pc ) {
+        report result;
+        std::size_t object_count{0};
+        long long bin_count{0}, read_bytes{0};
+
+        auto start = std::chrono::steady_clock::now();
+        for( auto const& job : job_pc ){
+            auto * file_h = opened( job.file );
+            if( !file_h ){ result.failure_c.push_back( job.output ); continue; }
+            //as render() would refuse it, selectors included
+            if( !prepared( job.config ) ){ result.failure_c.push_back( job.output ); continue; }
+
+            //only the file of the job, as render() looks for its histograms
+            auto const plan = configurator{}.plan( job.config, job.hist_list, lookup_context{ nullptr, { file_h } } );
+            object_count += plan.binding_c.size();
+            bin_count += plan.bin_count();
+            read_bytes += plan.read_bytes();
+            if( plan.ok() ){ ++result.rendered; continue; }
+
+            std::cerr << job.output << ": ";
+            plan.print( std::cerr );
+            result.failure_c.push_back( job.output );
+        }
+        result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        std::cout << "planned: " << job_pc.size() << " plots in " << result.seconds << "s, "
+                  << result.failure_c.size() << " would fail, "
+                  << object_count << " objects, " << bin_count << " bins at most, " << read_bytes << " bytes to read\n";
+        return result;
+    }
+
+    configurator::applier const& batch_renderer::prepared( std::string const& config_file_p ) {
+        auto applier_i = applier_mc.find( config_file_p );
+        if( applier_i == applier_mc.end() ){
+            applier_i = applier_mc.emplace( config_file_p, configurator{}.prepare( config_file_p ) ).first;
+        }
+        return applier_i->second;
+    }
+
+    //nullptr when the file could not be opened, which is remembered as well
+    TFile* batch_renderer::opened( std::string const& root_file_p ) {
+        auto file_i = file_mc.find( root_file_p );
+        if( file_i != file_mc.end() ){
+            use_mc.splice( use_mc.begin(), use_mc, file_i->second.use_i );
+            return file_i->second.file_h.get();
+        }
+
+        if( open_file_count_m && file_mc.size() >= open_file_count_m ){
+            file_mc.erase( use_mc.back() );
+            use_mc.pop_back();
+        }
+
+        std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str() ) };
+        if( !file_h || file_h->IsZombie() ){
+            std::cerr << "Could not open file: " << root_file_p << "\n";
+            file_h.reset();
+        }
+        use_mc.push_front( root_file_p );
+        return file_mc.emplace( root_file_p, open_file{ std::move(file_h), use_mc.begin() } ).first->second.file_h.get();
+    }
+
+    bool batch_renderer::render( job const& job_p ) {
+        auto const& applier = prepared( job_p.config );
+        if( !applier ){ return false; }
+
+        auto * file_h = opened( job_p.file );
+        if( !file_h ){ return false; }
+        auto const index_h = key_index::of( file_h );
+
+        std::vector<TH1D*> hist_c;
+        std::istringstream stream{ job_p.hist_list };
+        std::string name;
+        while( std::getline( stream, name, ';' ) ){
+            auto const * entry_h = index_h->resolve( name );
+            auto * hist_h = entry_h ? dynamic_cast<TH1D*>( read_object( file_h, *entry_h ) ) : nullptr;
+            if( !hist_h ){
+                std::cerr << "Could not find histogram " << name << " in " << job_p.file << "\n";
+                for( auto * read_h : hist_c ){ delete read_h; }
+                return false;
+            }
+            hist_h->SetDirectory( nullptr );
+            hist_c.push_back( hist_h );
+        }
+
+        auto read_c = hist_c;
+        auto * canvas_h = applier( std::move(hist_c) );
+        canvas_h->SaveAs( job_p.output.c_str() );
+
+        delete canvas_h;
+        for( auto * read_h : read_c ){ delete read_h; }
+        return true;
+    }
+
+} //namespace iwir
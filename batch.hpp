@@ -0,0 +1,80 @@
+//
+//File      : batch.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef batch_h
+#define batch_h
+
+//iwir header
+#include "configurator.hpp"
+#include "key_index.hpp"
+
+
+//std headers
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//ROOT header
+#include "TFile.h"
+
+
+namespace iwir {
+
+    //one plot to produce: the format is given by the extension of the output (png, pdf, svg, ...)
+    struct job {
+        std::string config;
+        std::string file;
+        std::string hist_list;
+        std::string output;
+    };
+
+    //one job per line: config root_file hist_1;hist_2;... output, lines starting with # are skipped
+    std::vector<job> read_manifest( std::string const& manifest_file_p );
+
+
+    struct batch_renderer {
+        struct report {
+            std::size_t rendered{0};
+            std::vector<std::string> failure_c;
+            double seconds{0};
+        };
+
+    public:
+        //at most open_file_count_p files are kept open at once, the least recently used being closed first
+        explicit batch_renderer( std::size_t open_file_count_p = 64 ) : open_file_count_m{ open_file_count_p } {}
+
+        report operator()( std::vector<job> const& job_pc );
+
+        //single job, batch mode has to be set by the caller
+        bool render( job const& job_p );
+
+        //dry run: every job is planned (see configurator::plan) without reading any histogram, so that a batch
+        //can be stopped before any rendering, rendered counting the jobs that would succeed
+        report plan( std::vector<job> const& job_pc );
+
+    private:
+        configurator::applier const& prepared( std::string const& config_file_p );
+        TFile* opened( std::string const& root_file_p );
+
+    private:
+        std::unordered_map< std::string, configurator::applier > applier_mc;
+        struct open_file {
+            std::unique_ptr<TFile> file_h;
+            std::list<std::string>::iterator use_i;
+        };
+        std::size_t open_file_count_m;
+        std::unordered_map< std::string, open_file > file_mc;
+        //most recently used first
+        std::list<std::string> use_mc;
+    };
+
+} //namespace iwir
+
+#endif /* batch_h */
@@ -0,0 +1,216 @@
+//
+//File      : bundle.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "bundle.hpp"
+#include "configurator.hpp"
+#include "image_cache.hpp"
+#include "root_context.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <sys/stat.h>
+
+namespace iwir {
+
+    namespace {
+        constexpr auto sidecar_header = "iwir-bundle 1";
+
+        long long modification_time( std::string const& file_p ) {
+            struct stat status;
+            return stat( file_p.c_str(), &status ) == 0 ? static_cast<long long>( status.st_mtime ) : 0;
+        }
+
+        std::string read_range( std::string const& file_p, long long offset_p, long long length_p ) {
+            std::ifstream input{ file_p, std::ios::binary };
+            std::string result( static_cast<std::size_t>( length_p ), '\0' );
+            input.seekg( offset_p );
+            if( !input.read( &result[0], length_p ) ){ return {}; }
+            return result;
+        }
+    }
+
+
+    std::unique_ptr<bundle_index> bundle_index::load( std::string const& bundle_p ) {
+        auto const sidecar = sidecar_of( bundle_p );
+        if( modification_time( sidecar ) < modification_time( bundle_p ) ){ return nullptr; }
+
+        std::ifstream input{ sidecar };
+        if( !input.is_open() ){ return nullptr; }
+
+        std::string line;
+        if( !std::getline( input, line ) || line != sidecar_header ){ return nullptr; }
+
+        //offset, length and hash, then the name tab separated: names may hold spaces
+        std::unique_ptr<bundle_index> result_h{ new bundle_index{} };
+        while( std::getline( input, line ) ){
+            std::istringstream stream{ line };
+            bundle_entry entry;
+            if( !( stream >> entry.offset >> entry.length >> std::hex >> entry.hash ) ){ return nullptr; }
+            stream.ignore( 1 );
+            if( !std::getline( stream, entry.name ) ){ return nullptr; }
+            result_h->add( std::move(entry) );
+        }
+        return result_h;
+    }
+
+    bool bundle_index::save( std::string const& sidecar_file_p ) const {
+        std::ofstream output{ sidecar_file_p };
+        if( !output.is_open() ){
+            std::cerr << "Could not open file: " << sidecar_file_p << "\n";
+            return false;
+        }
+
+        output << sidecar_header << '\n';
+        for( auto const& entry : entry_c ){
+            output << std::dec << entry.offset << ' ' << entry.length << ' ' << std::hex << entry.hash << '\t' << entry.name << '\n';
+        }
+        return static_cast<bool>( output );
+    }
+
+    void bundle_index::add( bundle_entry entry_p ) {
+        auto name_i = name_c.find( entry_p.name );
+        if( name_i != name_c.end() ){
+            entry_c[ name_i->second ] = std::move(entry_p);
+            return;
+        }
+        name_c.emplace( entry_p.name, entry_c.size() );
+        entry_c.push_back( std::move(entry_p) );
+    }
+
+    bundle_entry const* bundle_index::find( std::string const& name_p ) const {
+        auto name_i = name_c.find( name_p );
+        return name_i != name_c.end() ? &entry_c[ name_i->second ] : nullptr;
+    }
+
+
+    std::string read_bundle_entry( std::string const& bundle_p, std::string const& name_p ) {
+        static std::mutex mutex;
+        static bool const fork_held = ( hold_across_fork( mutex ), true );
+        (void)fork_held;
+        static std::unordered_map< std::string, std::pair< long long, std::unique_ptr<bundle_index> > > cache_c;
+
+        bundle_entry entry;
+        {
+            std::lock_guard<std::mutex> lock{ mutex };
+            auto& cached = cache_c[ bundle_p ];
+            auto const modification = modification_time( bundle_p );
+            if( !cached.second || cached.first != modification ){
+                cached = std::make_pair( modification, bundle_index::load( bundle_p ) );
+            }
+            if( !cached.second ){
+                std::cerr << "Could not load the index of bundle: " << bundle_p << "\n";
+                return {};
+            }
+
+            auto const* entry_h = cached.second->find( name_p );
+            if( !entry_h ){
+                std::cerr << "Could not find " << name_p << " in bundle: " << bundle_p << "\n";
+                return {};
+            }
+            entry = *entry_h;
+        }
+        return read_range( bundle_p, entry.offset, entry.length );
+    }
+
+
+    merge_report merge_configurations( std::vector<std::string> const& input_pc,
+                                       std::string const& bundle_p,
+                                       unsigned thread_count_p,
+                                       std::size_t chunk_size_p ) {
+        auto const start = std::chrono::steady_clock::now();
+        merge_report report;
+        report.input_count = input_pc.size();
+
+        thread_count_p = std::max( 1u, thread_count_p );
+        chunk_size_p = std::max<std::size_t>( 1, chunk_size_p );
+
+        auto const temporary_bundle = bundle_p + ".iwir-tmp";
+        std::fstream output{ temporary_bundle, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc };
+        if( !output.is_open() ){
+            std::cerr << "Could not open file: " << temporary_bundle << "\n";
+            return report;
+        }
+
+        bundle_index index;
+        //hash of the contents written so far, to the entries holding them: only offsets are kept, never the contents
+        std::unordered_map< std::uint64_t, std::vector<std::size_t> > written_c;
+        long long end{0};
+
+        std::vector<std::string> content_c;
+        for( std::size_t first{0} ; first < input_pc.size() ; first += chunk_size_p ){
+            auto const count = std::min( chunk_size_p, input_pc.size() - first );
+            content_c.assign( count, std::string{} );
+
+            //reading and filling only works on iwir images, no lock is needed
+            std::atomic<std::size_t> next{0};
+            auto work = [&](){
+                for( std::size_t i ; (i = next++) < count ; ){ content_c[i] = configurator{}.reformat( input_pc[first + i] ); }
+            };
+            std::vector<std::thread> thread_c;
+            for( unsigned i{1} ; i < std::min<std::size_t>( thread_count_p, count ) ; ++i ){ thread_c.emplace_back( work ); }
+            work();
+            for( auto& thread : thread_c ){ thread.join(); }
+
+            for( std::size_t i{0} ; i < count ; ++i ){
+                auto& content = content_c[i];
+                if( content.empty() ){ ++report.failed_count; continue; }
+
+                bundle_entry entry{ input_pc[first + i], end, static_cast<long long>( content.size() ), image_cache::hash( content ) };
+
+                //the hash only points at candidates, the bytes already written tell
+                auto& candidate_c = written_c[ entry.hash ];
+                auto const duplicate_i = std::find_if( candidate_c.begin(), candidate_c.end(), [&]( std::size_t candidate_p ){
+                    auto const& candidate = index.entries()[ candidate_p ];
+                    if( candidate.length != entry.length ){ return false; }
+                    output.flush();
+                    std::string written( content.size(), '\0' );
+                    output.seekg( candidate.offset );
+                    output.read( &written[0], candidate.length );
+                    return output && written == content;
+                } );
+                output.clear();
+                output.seekp( end );
+
+                auto const is_duplicate = duplicate_i != candidate_c.end();
+                if( is_duplicate ){ entry.offset = index.entries()[ *duplicate_i ].offset; }
+                else{
+                    output.write( content.data(), content.size() );
+                    end += entry.length;
+                    ++report.unique_count;
+                }
+                
+                auto const name = entry.name;
+                index.add( std::move(entry) );
+                if( !is_duplicate ){ candidate_c.push_back( index.find( name ) - index.entries().data() ); }
+                std::string{}.swap( content );
+            }
+        }
+
+        output.close();
+        auto const temporary_index = bundle_index::sidecar_of( temporary_bundle );
+        if( !output || !index.save( temporary_index ) ||
+            std::rename( temporary_bundle.c_str(), bundle_p.c_str() ) != 0 ||
+            std::rename( temporary_index.c_str(), bundle_index::sidecar_of( bundle_p ).c_str() ) != 0 ){
+            std::cerr << "Could not write bundle: " << bundle_p << "\n";
+            std::remove( temporary_bundle.c_str() );
+            std::remove( temporary_index.c_str() );
+        }
+        else{ report.written = true; }
+
+        report.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+        return report;
+    }
+
+} //namespace iwir
@@ -0,0 +1,72 @@
+//
+//File      : bundle.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef bundle_h
+#define bundle_h
+
+//std headers
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+namespace iwir {
+
+    //a bundle holds many configurations, one after the other as saver writes them, each distinct content once
+    //its index, in <bundle>.iwir-index, gives for every merged file where its content lies
+    //a configuration of a bundle is named <bundle>#<entry> wherever a configuration file is expected
+    struct bundle_entry {
+        std::string name;           //file the configuration was merged from
+        long long offset;
+        long long length;
+        std::uint64_t hash;         //of the content, shared by the entries it was deduplicated across
+    };
+
+    struct bundle_index {
+        static std::string sidecar_of( std::string const& bundle_p ) { return bundle_p + ".iwir-index"; }
+
+        //nullptr when there is no index, or when it is older than the bundle
+        static std::unique_ptr<bundle_index> load( std::string const& bundle_p );
+
+    public:
+        bool save( std::string const& sidecar_file_p ) const;
+
+        void add( bundle_entry entry_p );
+        bundle_entry const* find( std::string const& name_p ) const;
+
+        std::vector<bundle_entry> const& entries() const { return entry_c; }
+
+    private:
+        std::vector<bundle_entry> entry_c;
+        std::unordered_map< std::string, std::size_t > name_c;
+    };
+
+    //content of the entry, empty when it cannot be found; indexes are kept for the session
+    std::string read_bundle_entry( std::string const& bundle_p, std::string const& name_p );
+
+
+    struct merge_report {
+        std::size_t input_count{0};
+        std::size_t unique_count{0};
+        std::size_t failed_count{0};
+        bool written{false};        //bundle and index in place, nothing is left behind otherwise
+        double seconds{0};
+    };
+
+    //every file is read and written back as saver would, spread over thread_count_p threads, chunk_size_p files at a time:
+    //memory only grows with the size of a chunk, while the bundle and its index are written in the order of the files
+    //both are written aside and renamed when complete
+    merge_report merge_configurations( std::vector<std::string> const& input_pc,
+                                       std::string const& bundle_p,
+                                       unsigned thread_count_p,
+                                       std::size_t chunk_size_p = 1024 );
+
+} //namespace iwir
+
+#endif /* bundle_h */
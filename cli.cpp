@@ -0,0 +1,128 @@
+//
+//File      : cli.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//compiled entry point: no interpreter, hence no header parsing, before doing the work
+
+
+#include "saver.hpp"
+#include "configurator.hpp"
+#include "batch.hpp"
+#include "parallel_renderer.hpp"
+#include "key_index.hpp"
+#include "stream_renderer.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "TFile.h"
+#include "TROOT.h"
+
+namespace {
+
+    int usage() {
+        std::cerr << "usage: iwir save   <root_file> <canvas_name> <output_config>\n"
+                     "       iwir apply  <config> <root_file> <hist_1;hist_2;...> <output>\n"
+                     "       iwir render <manifest> [worker_count]\n"
+                     "       iwir plan   <manifest>\n"
+                     "       iwir stream <config> <root_file> <path_regex> <output_pattern> [budget_mb] [hist_per_plot]\n"
+                     "       iwir index  <root_file> [thread_count]\n"
+                     "       iwir codegen <config> <output_header> <function_name>\n";
+        return 1;
+    }
+
+    int save( std::string const& root_file_p, std::string const& canvas_name_p, std::string const& output_p ) {
+        std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str() ) };
+        if( !file_h || file_h->IsZombie() ){
+            std::cerr << "Could not open file: " << root_file_p << "\n";
+            return 1;
+        }
+
+        auto * canvas_h = dynamic_cast<TCanvas*>( file_h->Get( canvas_name_p.c_str() ) );
+        if( !canvas_h ){
+            std::cerr << "Could not find canvas " << canvas_name_p << " in " << root_file_p << "\n";
+            return 1;
+        }
+
+        iwir::saver{}( canvas_h, output_p );
+        iwir::saver::flush();
+        return 0;
+    }
+
+    int apply( iwir::job const& job_p ) {
+        gROOT->SetBatch( true );
+        return iwir::batch_renderer{}.render( job_p ) ? 0 : 1;
+    }
+
+    int render( std::string const& manifest_p, unsigned worker_count_p ) {
+        auto job_c = iwir::read_manifest( manifest_p );
+        auto report = worker_count_p == 1 ? iwir::batch_renderer{}( job_c ) :
+                                            iwir::parallel_renderer{ worker_count_p }( std::move(job_c) );
+        return report.failure_c.empty() ? 0 : 1;
+    }
+
+    //nothing is read nor drawn: the jobs which would fail are reported, with the cost of the whole batch
+    int plan( std::string const& manifest_p ) {
+        return iwir::batch_renderer{}.plan( iwir::read_manifest( manifest_p ) ).failure_c.empty() ? 0 : 1;
+    }
+
+    int stream( char* argv[], int argc ) {
+        std::size_t budget_mb = argc > 6 ? std::strtoul( argv[6], nullptr, 10 ) : 256;
+        std::size_t hist_per_plot = argc > 7 ? std::strtoul( argv[7], nullptr, 10 ) : 1;
+        auto report = iwir::stream_renderer{ budget_mb << 20, hist_per_plot }( argv[2], argv[3], argv[4], argv[5] );
+        return report.rendered ? 0 : 1;
+    }
+
+    int generate( std::string const& config_file_p, std::string const& output_p, std::string const& function_name_p ) {
+        auto code = iwir::configurator{}.generate( config_file_p, function_name_p );
+        if( code.empty() ){ return 1; }
+
+        std::ofstream output{ output_p };
+        if( !output.is_open() ){
+            std::cerr << "Could not open file: " << output_p << "\n";
+            return 1;
+        }
+        output << code;
+        return output ? 0 : 1;
+    }
+
+    int build_index( std::string const& root_file_p, unsigned thread_count_p ) {
+        std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str() ) };
+        if( !file_h || file_h->IsZombie() ){
+            std::cerr << "Could not open file: " << root_file_p << "\n";
+            return 1;
+        }
+
+        auto key_index = iwir::key_index::build( file_h.get(), thread_count_p );
+        std::cout << "indexed: " << key_index.entries().size() << " keys\n";
+        return key_index.save( iwir::key_index::sidecar_of( root_file_p ) ) ? 0 : 1;
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    if( argc < 2 ){ return usage(); }
+    std::string command{ argv[1] };
+
+    if( command == "save" && argc == 5 ){ return save( argv[2], argv[3], argv[4] ); }
+    if( command == "apply" && argc == 6 ){ return apply( iwir::job{ argv[2], argv[3], argv[4], argv[5] } ); }
+    if( command == "render" && (argc == 3 || argc == 4) ){
+        return render( argv[2], argc == 4 ? std::strtoul( argv[3], nullptr, 10 ) : 0 );
+    }
+
+    if( command == "plan" && argc == 3 ){ return plan( argv[2] ); }
+    if( command == "stream" && argc >= 6 && argc <= 8 ){ return stream( argv, argc ); }
+    if( command == "codegen" && argc == 5 ){ return generate( argv[2], argv[3], argv[4] ); }
+    if( command == "index" && (argc == 3 || argc == 4) ){
+        return build_index( argv[2], argc == 4 ? std::strtoul( argv[3], nullptr, 10 ) : 1 );
+    }
+
+    return usage();
+}
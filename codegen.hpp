@@ -0,0 +1,212 @@
+//
+//File      : codegen.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef codegen_h
+#define codegen_h
+
+//iwir header
+#include "configuration_image.hpp"
+
+
+//std headers
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+
+namespace iwir {
+
+    //------------------------------type_name----------------------------------------
+    //spelling of the image types in generated code
+
+    template<class T> struct type_name;
+
+    template<> struct type_name<size>       { static std::string value(){ return "iwir::size"; } };
+    template<> struct type_name<style>      { static std::string value(){ return "iwir::style"; } };
+    template<> struct type_name<width>      { static std::string value(){ return "iwir::width"; } };
+    template<> struct type_name<offset>     { static std::string value(){ return "iwir::offset"; } };
+    template<> struct type_name<plain_text> { static std::string value(){ return "iwir::plain_text"; } };
+    template<> struct type_name<user_text>  { static std::string value(){ return "iwir::user_text"; } };
+    template<> struct type_name<low>        { static std::string value(){ return "iwir::low"; } };
+    template<> struct type_name<high>       { static std::string value(){ return "iwir::high"; } };
+    template<> struct type_name<color>      { static std::string value(){ return "iwir::color"; } };
+
+    template<> struct type_name<x>        { static std::string value(){ return "iwir::x"; } };
+    template<> struct type_name<y>        { static std::string value(){ return "iwir::y"; } };
+    template<> struct type_name<single>   { static std::string value(){ return "iwir::single"; } };
+    template<> struct type_name<multiple> { static std::string value(){ return "iwir::multiple"; } };
+
+    template<class T> struct type_name< label<T> >  { static std::string value(){ return "iwir::label<" + type_name<T>::value() + ">"; } };
+    template<class T> struct type_name< range<T> >  { static std::string value(){ return "iwir::range<" + type_name<T>::value() + ">"; } };
+    template<class T> struct type_name< title<T> >  { static std::string value(){ return "iwir::title<" + type_name<T>::value() + ">"; } };
+    template<class T> struct type_name< header<T> > { static std::string value(){ return "iwir::header<" + type_name<T>::value() + ">"; } };
+    template<> struct type_name<marker>            { static std::string value(){ return "iwir::marker"; } };
+    template<> struct type_name<line>              { static std::string value(){ return "iwir::line"; } };
+    template<> struct type_name<legend_attributes> { static std::string value(){ return "iwir::legend_attributes"; } };
+    template<> struct type_name<selector>          { static std::string value(){ return "iwir::selector"; } };
+    template<> struct type_name<option>            { static std::string value(){ return "iwir::option"; } };
+    template<> struct type_name<name>              { static std::string value(){ return "iwir::name"; } };
+    template<> struct type_name<sampling>          { static std::string value(){ return "iwir::sampling"; } };
+
+    template<> struct type_name<pad>         { static std::string value(){ return "iwir::pad"; } };
+    template<> struct type_name<frame1d>     { static std::string value(){ return "iwir::frame1d"; } };
+    template<> struct type_name<histogram1d> { static std::string value(){ return "iwir::histogram1d"; } };
+    template<> struct type_name<legend>      { static std::string value(){ return "iwir::legend"; } };
+    template<> struct type_name<pave_text>   { static std::string value(){ return "iwir::pave_text"; } };
+    template<> struct type_name<graph>       { static std::string value(){ return "iwir::graph"; } };
+
+    template<class ... Ts>
+    struct type_name< configuration<Ts...> > {
+        static std::string value(){
+            std::string result;
+            int expander[] = { 0, (result += (result.empty() ? "" : ", ") + type_name<Ts>::value(), void(), 0) ... };
+            return "iwir::configuration< " + result + " >";
+        }
+    };
+
+
+    //------------------------------literal----------------------------------------
+
+    inline std::string literal( double value_p ) {
+        std::ostringstream stream;
+        stream << std::setprecision(17) << value_p;
+        return stream.str();
+    }
+
+    inline std::string literal( int value_p ) { return std::to_string( value_p ); }
+
+    //octal escapes for anything unprintable: unlike hexadecimal ones, they cannot swallow the next character
+    template<class Allocator>
+    std::string literal( std::basic_string<char, std::char_traits<char>, Allocator> const& value_p ) {
+        std::string result{ '"' };
+        for( unsigned char c : value_p ){
+            if( c == '"' || c == '\\' ){ result += '\\'; result += c; }
+            else if( c < 0x20 || c > 0x7e ){
+                char escaped[5];
+                std::snprintf( escaped, sizeof(escaped), "\\%03o", c );
+                result += escaped;
+            }
+            else{ result += c; }
+        }
+        return result + '"';
+    }
+
+
+    //------------------------------code----------------------------------------
+
+    namespace code {
+
+        template<class Field, class ... Entries>
+        std::string fill( Field const& field_p, std::tuple<Entries...> ) {
+            std::string type_c, value_c;
+            int expander[] = { 0, ( type_c += (type_c.empty() ? "" : ", ") + type_name<Entries>::value(),
+                                    value_c += (value_c.empty() ? "" : ", ") + literal( static_cast<Entries const&>(field_p).value() ),
+                                    void(), 0 ) ... };
+            return ".fill< " + type_c + " >( " + value_c + " );\n";
+        }
+
+        template<class Field>
+        std::string field( single_value_field<Field> const& field_p, std::string const& indent_p ) {
+            return indent_p + "element.retrieve_field< " + type_name<Field>::value() + " >()" +
+                   fill( field_p.retrieve(), typename Field::entries{} );
+        }
+
+        template<class Field>
+        std::string field( multiple_value_field<Field> const& field_p, std::string const& indent_p ) {
+            std::string result;
+            for( auto const& value : field_p ){
+                result += indent_p + "element.retrieve_field< " + type_name<Field>::value() + " >().add_value()" +
+                          fill( value.retrieve(), typename Field::entries{} );
+            }
+            return result;
+        }
+
+        template<class Element, class ... Fields>
+        std::string fields( Element const& element_p, std::string const& indent_p, std::tuple<Fields...> ) {
+            std::string result;
+            int expander[] = { 0, (result += field( element_p.template retrieve_field<Fields>(), indent_p ), void(), 0) ... };
+            return result;
+        }
+
+        template<class Element>
+        std::string element( single_value_element<Element> const& element_p ) {
+            return "    {\n"
+                   "        auto & element = image.retrieve_element< " + type_name<Element>::value() + " >();\n" +
+                   fields( element_p, "        ", typename Element::fields{} ) +
+                   "    }\n";
+        }
+
+        template<class Element>
+        std::string element( multiple_value_element<Element> const& element_p ) {
+            std::string result;
+            for( auto const& value : element_p ){
+                result += "    {\n"
+                          "        auto & element = image.retrieve_element< " + type_name<Element>::value() + " >().add_value();\n" +
+                          fields( value, "        ", typename Element::fields{} ) +
+                          "    }\n";
+            }
+            return result;
+        }
+
+        template<class Element>
+        std::string element( columnar_value_element<Element> const& element_p ) {
+            std::string result;
+            for( auto const& value : element_p ){
+                result += "    {\n"
+                          "        auto element = image.retrieve_element< " + type_name<Element>::value() + " >().add_value();\n" +
+                          fields( value, "        ", typename Element::fields{} ) +
+                          "    }\n";
+            }
+            return result;
+        }
+
+        template<class Image, class ... Elements>
+        std::string elements( Image const& image_p, std::tuple<Elements...> ) {
+            std::string result;
+            int expander[] = { 0, (result += element( image_p.template retrieve_element<Elements>() ), void(), 0) ... };
+            return result;
+        }
+
+    } //namespace code
+
+
+    //header defining make_<function_name_p>(), which fills the image of the configuration entry by entry,
+    //and <function_name_p>(), the same image shared by every caller and built on first use
+    template<class Image>
+    std::string generate_code( Image const& image_p,
+                               std::string const& function_name_p,
+                               std::string const& config_file_p ) {
+        using configuration_type = typename Image::configuration_type;
+        auto const image_type = "iwir::image< " + type_name<configuration_type>::value() + " >";
+        auto const shared_type = "iwir::shared_image< " + type_name<configuration_type>::value() + " >";
+        auto const guard = "iwir_generated_" + function_name_p + "_h";
+
+        return "//\n"
+               "//generated by iwir codegen from " + config_file_p + ", do not edit\n"
+               "//\n\n"
+               "#ifndef " + guard + "\n"
+               "#define " + guard + "\n\n"
+               "#include \"shared_image.hpp\"\n\n"
+               "namespace iwir_generated {\n\n"
+               "inline " + image_type + " make_" + function_name_p + "() {\n"
+               "    auto image = iwir::make_image< " + type_name<configuration_type>::value() + " >();\n" +
+               code::elements( image_p, typename configuration_type::elements{} ) +
+               "    return image;\n"
+               "}\n\n"
+               "inline " + shared_type + " const& " + function_name_p + "() {\n"
+               "    static " + shared_type + " const image{ make_" + function_name_p + "() };\n"
+               "    return image;\n"
+               "}\n\n"
+               "} //namespace iwir_generated\n\n"
+               "#endif /* " + guard + " */\n";
+    }
+
+} //namespace iwir
+
+#endif /* codegen_h */
@@ -9,12 +9,24 @@
 #define configuration_image_h
 
 #include "constexpr_string.hpp"
+#include "arena.hpp"
+#include "inline_vector.hpp"
 
 #include <tuple>
 #include <cstring>
 #include <iostream>
 #include <vector>
 
+namespace details {
+    template<class T, class U>
+    void assign( T& t_p, U const& u_p ){ t_p = u_p; }
+    
+    template<class Allocator>
+    void assign( std::basic_string<char, std::char_traits<char>, Allocator>& t_p, std::string const& u_p ){
+        t_p.assign( u_p.data(), u_p.size() );
+    }
+} //namespace details
+
 namespace iwir {
     
     //------------------------------entry----------------------------------------
@@ -48,20 +60,20 @@ namespace iwir {
     };
     
     struct plain_text {
-        std::string data;
-        std::string plain_data() const { return data; }
-        std::string      &  value()       { return data; }
-        std::string const&  value() const { return data; }
-        std::string content() const { return details::concatenate( "plain_text:=", data);  }
+        arena_string data;
+        std::string plain_data() const { return std::string{ data.begin(), data.end() }; }
+        arena_string      &  value()       { return data; }
+        arena_string const&  value() const { return data; }
+        std::string content() const { return details::concatenate( "plain_text:=", data.c_str());  }
     };
     
     struct user_text {
-        std::string data;
+        arena_string data;
 //        std::string user_data() const { return std::string{data.begin()+1, data.end()-1}; }
-        std::string user_data() const { return data; }
-        std::string      &  value()       { return data; }
-        std::string const&  value() const { return data; }
-        std::string content() const { return details::concatenate( "user_text:=[", data, "]");  }
+        std::string user_data() const { return std::string{ data.begin(), data.end() }; }
+        arena_string      &  value()       { return data; }
+        arena_string const&  value() const { return data; }
+        std::string content() const { return details::concatenate( "user_text:=[", data.c_str(), "]");  }
     };
     
     struct low {
@@ -95,7 +107,7 @@ namespace iwir {
     struct filler {
         template<class ... Ts, class ...Us> //match with Ts ?
         constexpr void fill( Us... us_p ){
-            int expander[] = { 0, (static_cast<Ts&>(derived()).value() = us_p, void(), 0) ... };
+            int expander[] = { 0, (details::assign( static_cast<Ts&>(derived()).value(), us_p ), void(), 0) ... };
         }
         
     private:
@@ -103,8 +115,22 @@ namespace iwir {
         Derived const& derived() const {return static_cast<Derived const&>(*this);}
     };
     
+    //true when every entry of both fields holds the same value
+    template<class Field, class ... Entries>
+    bool same_entries( Field const& lhs_p, Field const& rhs_p, std::tuple<Entries...> ){
+        bool result{true};
+        int expander[] = { 0, (result = result && static_cast<Entries const&>(lhs_p).value() == static_cast<Entries const&>(rhs_p).value(), void(), 0) ... };
+        return result;
+    }
+    template<class Field>
+    bool same_entries( Field const& lhs_p, Field const& rhs_p ){
+        return same_entries( lhs_p, rhs_p, typename Field::entries{} );
+    }
+    
     template<class Derived, class ... Ts>
     struct field_formatter {
+        using entries = std::tuple<Ts...>;
+        
         std::string retrieve_content() const {
             return details::concatenate_with_separator(";",  static_cast<Ts const&>(derived()).content()... );
         }
@@ -129,6 +155,7 @@ namespace iwir {
     struct field_traits{
         using value_type = single_value_field<T>;
         using is_silent = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 0>;
     };
     
     
@@ -174,12 +201,28 @@ namespace iwir {
     };
     
     
+    //glob or /regex/ on histogram names, empty when the entry is bound by position
+    struct selector : user_text,
+                      filler<selector>,
+                      field_formatter<selector, user_text> {
+        static constexpr details::constexpr_string<8> anchor = details::make_constexpr_string("selector");
+    };
+    
+    
     struct option : plain_text,
                     filler<option>,
                     field_formatter<option, plain_text> {
         static constexpr details::constexpr_string<6> anchor = details::make_constexpr_string("option");
     };
     
+    //reduction of the points of a graph before drawing, empty to draw them all
+    //plain_text:=minmax (first, last, lowest and highest point of each pixel column) or lttb (largest triangle three buckets)
+    struct sampling : plain_text,
+                      filler<sampling>,
+                      field_formatter<sampling, plain_text> {
+        static constexpr details::constexpr_string<8> anchor = details::make_constexpr_string("sampling");
+    };
+    
     template<class T>
     struct header : user_text, size, color,
                     filler<header<T>>,
@@ -192,21 +235,27 @@ namespace iwir {
     {
         using value_type = single_value_field< header<single> >;
         using is_silent = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 0>;
     };
+    //pave_text rarely holds more than a handful of lines
     template<> struct field_traits< header<multiple> >
     {
         using value_type = multiple_value_field< header<multiple> >;
         using is_silent = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 4>;
     };
     
     
     struct name : plain_text,
-                  filler<name> {};
+                  filler<name> {
+        using entries = std::tuple<plain_text>;
+    };
     
     template<> struct field_traits< name >
     {
         using value_type = single_value_field< name >;
         using is_silent = std::true_type;
+        using inline_capacity = std::integral_constant<std::size_t, 0>;
     };
     
     
@@ -215,10 +264,12 @@ namespace iwir {
     template<class T> struct element;
     template<class T> struct single_value_element;
     template<class T> struct multiple_value_element;
+    template<class T> struct columnar_value_element;
     template<class T>
     struct element_traits{
         using value_type = single_value_element<T>;
         using is_single_value = std::true_type;
+        using inline_capacity = std::integral_constant<std::size_t, 0>;
     };
     
     
@@ -226,13 +277,27 @@ namespace iwir {
     
     struct histogram1d{
         static constexpr details::constexpr_string<6> anchor = details::make_constexpr_string("hist1d");
-        using fields = std::tuple< name, legend_attributes, option, marker, line >;
+        using fields = std::tuple< name, selector, legend_attributes, option, marker, line >;
     };
     
+    //stored column-wise: a canvas can hold thousands of them, and they are mostly walked one field at a time
     template<>
     struct element_traits<histogram1d>{
-        using value_type = multiple_value_element<histogram1d>;
+        using value_type = columnar_value_element<histogram1d>;
+        using is_single_value = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 0>;
+    };
+    
+    //graphs are bound by position only
+    struct graph{
+        static constexpr details::constexpr_string<5> anchor = details::make_constexpr_string("graph");
+        using fields = std::tuple< name, legend_attributes, option, marker, line, sampling >;
+    };
+    template<>
+    struct element_traits<graph>{
+        using value_type = multiple_value_element<graph>;
         using is_single_value = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 4>;
     };
     
     //    struct histogram2d{
@@ -264,6 +329,7 @@ namespace iwir {
     struct element_traits<pave_text>{
         using value_type = multiple_value_element<pave_text>;
         using is_single_value = std::false_type;
+        using inline_capacity = std::integral_constant<std::size_t, 4>;
     };
     
     
@@ -371,7 +437,7 @@ namespace iwir {
         auto end() const { return value_mc.end(); }
         
     private:
-        std::vector< field<T> > value_mc;
+        inline_container< field<T>, field_traits<T>::inline_capacity::value > value_mc;
     };
     
     
@@ -449,7 +515,105 @@ namespace iwir {
         auto end() const { return value_mc.end(); }
         
     private:
-        std::vector< element<T> > value_mc;
+        inline_container< element<T>, element_traits<T>::inline_capacity::value > value_mc;
+    };
+    
+    
+    
+    template<class Field>
+    using field_column = arena_vector< typename field_traits<Field>::value_type >;
+    
+    //structure of arrays: one contiguous column per field, values of the i-th element sit at index i
+    //columns stop at the field rather than at each scalar: a field is a few adjacent scalars always read and set
+    //together (marker: size, style, color), and the fillers, formatters and codec all work on whole fields
+    template<class T>
+    struct columnar_value_element {
+        using column_tuple = typename convert<field_column, typename T::fields>::type_list;
+        
+        //stands in for an element<T>, pointing into the columns
+        template<class Columns>
+        struct reference {
+        private:
+            template<std::size_t ... Indices>
+            std::string retrieve_content_impl( std::index_sequence<Indices...> ) const {
+                return details::concatenate(
+                                            "<", T::anchor, ">",
+                                            std::get<Indices>(*column_mch)[index_m].retrieve_content()...,
+                                            "\n<", T::anchor, ">"
+                                            );
+            }
+            
+        public:
+            std::string retrieve_content() const {
+                return retrieve_content_impl( std::make_index_sequence< std::tuple_size<column_tuple>::value >{});
+            }
+            
+            template<class Field>
+            auto& retrieve_field() const { return std::get< field_column<Field> >(*column_mch)[index_m]; }
+            
+            Columns* column_mch;
+            std::size_t index_m;
+        };
+        
+        template<class Reference>
+        struct iterator {
+            Reference operator*() const { return reference_m; }
+            iterator& operator++(){ ++reference_m.index_m; return *this; }
+            bool operator==( iterator const& other_p ) const { return reference_m.index_m == other_p.reference_m.index_m; }
+            bool operator!=( iterator const& other_p ) const { return reference_m.index_m != other_p.reference_m.index_m; }
+            
+            Reference reference_m;
+        };
+        
+    public:
+        std::string retrieve_content() const {
+            std::string result;
+            for( auto const& value : *this ){
+                result += '\n' + value.retrieve_content();
+            }
+            return result ;
+        }
+        
+        reference<column_tuple> operator[](std::size_t index_p){ return {&column_mc, index_p}; }
+        reference<column_tuple const> operator[](std::size_t index_p) const { return {&column_mc, index_p}; }
+        
+        reference<column_tuple> add_value(){
+            add_value_impl( std::make_index_sequence< std::tuple_size<column_tuple>::value >{} );
+            return {&column_mc, size() - 1};
+        }
+        
+        std::size_t size() const { return std::get<0>(column_mc).size(); }
+        
+        //appends a copy of the index_p-th element of source_p
+        reference<column_tuple> add_copy( columnar_value_element const& source_p, std::size_t index_p ){
+            add_copy_impl( source_p, index_p, std::make_index_sequence< std::tuple_size<column_tuple>::value >{} );
+            return {&column_mc, size() - 1};
+        }
+        
+        //whole column of one field, for bulk operations streaming over every element
+        template<class Field>
+        field_column<Field> & retrieve_column() { return std::get< field_column<Field> >(column_mc); }
+        template<class Field>
+        field_column<Field> const& retrieve_column() const { return std::get< field_column<Field> >(column_mc); }
+        
+        iterator< reference<column_tuple> > begin() { return { {&column_mc, 0} }; }
+        iterator< reference<column_tuple const> > begin() const { return { {&column_mc, 0} }; }
+        iterator< reference<column_tuple> > end() { return { {&column_mc, size()} }; }
+        iterator< reference<column_tuple const> > end() const { return { {&column_mc, size()} }; }
+        
+    private:
+        template<std::size_t ... Indices>
+        void add_value_impl( std::index_sequence<Indices...> ){
+            int expander[] = { 0, (std::get<Indices>(column_mc).emplace_back(), void(), 0) ... };
+        }
+        
+        template<std::size_t ... Indices>
+        void add_copy_impl( columnar_value_element const& source_p, std::size_t index_p, std::index_sequence<Indices...> ){
+            int expander[] = { 0, (std::get<Indices>(column_mc).push_back( std::get<Indices>(source_p.column_mc)[index_p] ), void(), 0) ... };
+        }
+        
+    private:
+        column_tuple column_mc;
     };
     
     
@@ -463,18 +627,27 @@ namespace iwir {
     };
     
     
+    template<class Element, class ... Ts>
+    constexpr bool holds_element( configuration<Ts...> ) {
+        bool result{false};
+        int expander[] = { 0, (result = result || std::is_same<Element, Ts>::value, 0) ... };
+        return result;
+    }
+    
+    
     template<class Configuration>
     struct image {
+        using configuration_type = Configuration;
         using element_tuple = typename convert< element, typename Configuration::elements>::type_list;
         
     private:
         template<std::size_t ... Indices>
-        std::string retrieve_content_impl( std::index_sequence<Indices...>) {
+        std::string retrieve_content_impl( std::index_sequence<Indices...>) const {
             return details::concatenate( std::get<Indices>(element_mc).retrieve_content()... );
         }
         
     public:
-        std::string retrieve_content() {
+        std::string retrieve_content() const {
             return retrieve_content_impl( std::make_index_sequence< std::tuple_size<element_tuple>::value>{} );
         }
         
@@ -6,14 +6,18 @@
 //
 
 #include "configurator.hpp"
+#include "bundle.hpp"
+#include "codegen.hpp"
 #include "flag_set.hpp"
+#include "key_index.hpp"
+#include "scanner.hpp"
 
+#include <cstdio>
 #include <fstream>
 
-#include "TROOT.h"
+#include "TClass.h"
 #include "TDirectory.h"
 #include "TFile.h"
-#include "TKey.h"
 
 namespace iwir {
 
@@ -35,7 +39,7 @@ namespace iwir {
     
     std::string regex_first_match( std::string const & text_p, std::regex regex_p ) {
         std::sregex_iterator match_i{ text_p.begin(), text_p.end(), regex_p };
-        return match_i->str();
+        return match_i != std::sregex_iterator{} ? match_i->str() : std::string{};
     }
     
     std::string remove_outer_tag( std::string text_p ){
@@ -55,36 +59,58 @@ namespace iwir {
     void configurator::operator()( std::string const& config_file_p,
                                    std::string const & hist_list_p ) const
     {
- 
-        auto hist_c = find( regex_split(hist_list_p, std::regex{"(\\w| )+([^;]|$)"} ) );
+        (*this)( config_file_p, hist_list_p, lookup_context::current() );
+    }
+    
+    void configurator::operator()( std::string const& config_file_p,
+                                   std::string const & hist_list_p,
+                                   lookup_context const& context_p ) const
+    {
+        auto name_c = regex_split(hist_list_p, std::regex{"[^;]+"});
+        auto content = read(config_file_p);
+        
+        //graphs are looked for only when the configuration asks for them
+        if( content.opcode & flag_set<graph_flag>{} ){
+            draw_graphs( std::move(content), name_c, context_p );
+            return;
+        }
+        
+        auto hist_c = find( std::move(name_c), context_p );
         
         std::cout << "found: " << hist_c.size() << "hists\n";
         
-        auto content = read(config_file_p);
-        //add check on size ? match between hist size and config
+        //the whole image is built in one region, given back at once when leaving
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        
+        //histograms and positional entries are matched in order by bind(), which warns when their counts differ
         switch (content.opcode) {
             case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
                 auto config = make_image< configuration< frame1d, histogram1d, legend, pave_text > >();
-                config = fill( std::move(config), std::move(content.element_c) );
-                apply( std::move(config), std::move( hist_c ) );
+                config = fill( std::move(config), std::move(content) );
+                auto bound_c = bind( config, std::move( hist_c ), context_p );
+                apply( std::move(config), std::move( bound_c ) );
                 break;
             }
             case flag_set<hist1d_flag, legend_flag>{} :{
                 auto config = make_image< configuration< frame1d, histogram1d, legend > >();
-                config = fill( std::move(config), std::move(content.element_c) );
-                apply( std::move(config), std::move( hist_c ) );
+                config = fill( std::move(config), std::move(content) );
+                auto bound_c = bind( config, std::move( hist_c ), context_p );
+                apply( std::move(config), std::move( bound_c ) );
                 break;
             }
             case flag_set<hist1d_flag, pave_text_flag>{} :{
                 auto config = make_image< configuration< frame1d, histogram1d, pave_text > >();
-                config = fill( std::move(config), std::move(content.element_c) );
-                apply( std::move(config), std::move( hist_c ) );
+                config = fill( std::move(config), std::move(content) );
+                auto bound_c = bind( config, std::move( hist_c ), context_p );
+                apply( std::move(config), std::move( bound_c ) );
                 break;
             }
             case flag_set<hist1d_flag>{} :{
                 auto config = make_image< configuration< frame1d, histogram1d> >();
-                config = fill( std::move(config), std::move(content.element_c) );
-                apply( std::move(config), std::move( hist_c ) );
+                config = fill( std::move(config), std::move(content) );
+                auto bound_c = bind( config, std::move( hist_c ), context_p );
+                apply( std::move(config), std::move( bound_c ) );
                 break;
             }
             default:{
@@ -96,111 +122,664 @@ namespace iwir {
     }
     
     
-    //will probably need reverse switch to get mask out and call proper find with th2
-    //or base on configuration ?
-    std::vector<TH1D*> configurator::find( std::vector<std::string> && hist_p ) const {
-        std::vector<TH1D*> result_c;
+    void configurator::draw_graphs( formatted_content content_p,
+                                    std::vector<std::string> const& name_pc,
+                                    lookup_context const& context_p ) const
+    {
+        auto graph_c = find_graphs( name_pc, context_p );
         
-        //current directory first, then look in registered files
-        auto * current_directory_h = TDirectory::CurrentDirectory();
-        std::cout << "directory: " << current_directory_h->GetName() << '\n';
-        auto& object_c = *current_directory_h->GetList();
-        for( auto * object_h : object_c ){
-            std::cout << "Current object: " << object_h->GetName() << '\n';
-            auto hist_i = std::find_if(
-                                hist_p.begin(), hist_p.end(),
-                                [&object_h]( std::string const& name_p )
-                                { return name_p == std::string{ object_h->GetName() }; }
-                                       );
-            if( hist_i != hist_p.end() ){
+        std::cout << "found: " << graph_c.size() << "graphs\n";
+        
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        
+        switch (content_p.opcode) {
+            case flag_set<graph_flag, legend_flag, pave_text_flag>{}:{
+                auto config = fill( make_image< configuration< frame1d, graph, legend, pave_text > >(), std::move(content_p) );
+                apply_graphs( config, std::move( graph_c ) );
+                break;
+            }
+            case flag_set<graph_flag, legend_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph, legend > >(), std::move(content_p) );
+                apply_graphs( config, std::move( graph_c ) );
+                break;
+            }
+            case flag_set<graph_flag, pave_text_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph, pave_text > >(), std::move(content_p) );
+                apply_graphs( config, std::move( graph_c ) );
+                break;
+            }
+            case flag_set<graph_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph > >(), std::move(content_p) );
+                apply_graphs( config, std::move( graph_c ) );
+                break;
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content_p.opcode) << '\n';
+                break;
+            }
+        }
+    }
+    
+    
+    configurator::applier configurator::prepare( std::string const& config_file_p ) const
+    {
+        auto content = read(config_file_p);
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return make_applier( share< frame1d, histogram1d, legend, pave_text >( std::move(content) ), config_file_p );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return make_applier( share< frame1d, histogram1d, legend >( std::move(content) ), config_file_p );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return make_applier( share< frame1d, histogram1d, pave_text >( std::move(content) ), config_file_p );
+            }
+            case flag_set<hist1d_flag>{} :{
+                return make_applier( share< frame1d, histogram1d >( std::move(content) ), config_file_p );
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return {};
+            }
+        }
+    }
+    
+    
+    void configurator::apply_style( std::string const& config_file_p,
+                                    std::vector<TH1*> const& hist_pc ) const
+    {
+        auto styler = prepare_style( config_file_p );
+        if( styler ){ styler( hist_pc, 0 ); }
+    }
+    
+    configurator::styler configurator::prepare_style( std::string const& config_file_p ) const
+    {
+        auto content = read(config_file_p);
+        if( !(content.opcode & flag_set<hist1d_flag>{}) ){
+            std::cerr << "No histogram style in: " << config_file_p << '\n';
+            return {};
+        }
+        
+        auto config = share< frame1d, histogram1d >( std::move(content) );
+        if( carries_selector( config, config_file_p ) ){ return {}; }
+        return [config]( std::vector<TH1*> const& hist_pc, std::size_t first_index_p )
+               { configurator{}.apply_style_impl( config, hist_pc, first_index_p ); };
+    }
+    
+    
+    std::unique_ptr<applied_configuration> configurator::apply_tracked( std::string const& config_file_p,
+                                                                        std::string const& hist_list_p,
+                                                                        TCanvas* canvas_ph ) const
+    {
+        auto hist_c = find( regex_split(hist_list_p, std::regex{"[^;]+"} ), lookup_context::current() );
+        auto content = read(config_file_p);
+        
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return track< frame1d, histogram1d, legend, pave_text >( std::move(content), std::move(hist_c), canvas_ph );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return track< frame1d, histogram1d, legend >( std::move(content), std::move(hist_c), canvas_ph );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return track< frame1d, histogram1d, pave_text >( std::move(content), std::move(hist_c), canvas_ph );
+            }
+            case flag_set<hist1d_flag>{} :{
+                return track< frame1d, histogram1d >( std::move(content), std::move(hist_c), canvas_ph );
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return nullptr;
+            }
+        }
+    }
+    
+    bool configurator::update( applied_configuration& applied_p, std::string const& config_file_p ) const
+    {
+        auto content = read(config_file_p);
+        if( content.opcode != applied_p.opcode || !applied_p.canvas_h ){ return false; }
+        
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return update_as< frame1d, histogram1d, legend, pave_text >( applied_p, std::move(content) );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return update_as< frame1d, histogram1d, legend >( applied_p, std::move(content) );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return update_as< frame1d, histogram1d, pave_text >( applied_p, std::move(content) );
+            }
+            case flag_set<hist1d_flag>{} :{
+                return update_as< frame1d, histogram1d >( applied_p, std::move(content) );
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return false;
+            }
+        }
+    }
+    
+    
+    std::unique_ptr<applied_configuration> configurator::parse( std::string const& config_file_p ) const
+    {
+        auto content = read(config_file_p);
+        
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return parse_as< frame1d, histogram1d, legend, pave_text >( std::move(content) );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return parse_as< frame1d, histogram1d, legend >( std::move(content) );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return parse_as< frame1d, histogram1d, pave_text >( std::move(content) );
+            }
+            case flag_set<hist1d_flag>{} :{
+                return parse_as< frame1d, histogram1d >( std::move(content) );
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return nullptr;
+            }
+        }
+    }
+    
+    bool configurator::update( applied_configuration& applied_p, applied_configuration const& parsed_p ) const
+    {
+        if( parsed_p.opcode != applied_p.opcode || !applied_p.canvas_h ){ return false; }
+        
+        switch (parsed_p.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return update_from< frame1d, histogram1d, legend, pave_text >( applied_p, parsed_p );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return update_from< frame1d, histogram1d, legend >( applied_p, parsed_p );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return update_from< frame1d, histogram1d, pave_text >( applied_p, parsed_p );
+            }
+            case flag_set<hist1d_flag>{} :{
+                return update_from< frame1d, histogram1d >( applied_p, parsed_p );
+            }
+            default:{
+                return false;
+            }
+        }
+    }
+    
+    
+    void configurator::apply_elements( std::string const& config_file_p, uint8_t element_mask_p, TCanvas* canvas_ph ) const
+    {
+        if( !canvas_ph ){ return; }
+        auto content = read( config_file_p, element_mask_p );
+        
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        auto config = fill( make_image< configuration< frame1d, histogram1d, legend, pave_text > >(), std::move(content) );
+        
+        root_guard guard{ root_mutex() };
+        auto drawn = collect( canvas_ph );
+        canvas_ph->cd();
+        
+        if( element_mask_p & flag_set<pad_flag>{} ){ apply_onto( config, canvas_ph, drawn, pad{} ); }
+        if( element_mask_p & flag_set<frame_flag>{} ){ apply_onto( config, canvas_ph, drawn, frame1d{} ); }
+        if( element_mask_p & flag_set<hist1d_flag>{} ){ apply_onto( config, canvas_ph, drawn, histogram1d{} ); }
+        if( element_mask_p & flag_set<pave_text_flag>{} ){ apply_onto( config, canvas_ph, drawn, pave_text{} ); }
+        if( element_mask_p & flag_set<legend_flag>{} ){ apply_onto( config, canvas_ph, drawn, legend{} ); }
+        
+        canvas_ph->Modified();
+        canvas_ph->Update();
+    }
+    
+    
+    std::string configurator::reformat( std::string const& config_file_p ) const
+    {
+        auto content = read(config_file_p);
+        
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                return fill( make_image< configuration< frame1d, histogram1d, legend, pave_text > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                return fill( make_image< configuration< frame1d, histogram1d, legend > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                return fill( make_image< configuration< frame1d, histogram1d, pave_text > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<hist1d_flag>{} :{
+                return fill( make_image< configuration< frame1d, histogram1d > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<graph_flag, legend_flag, pave_text_flag>{}:{
+                return fill( make_image< configuration< frame1d, graph, legend, pave_text > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<graph_flag, legend_flag>{} :{
+                return fill( make_image< configuration< frame1d, graph, legend > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<graph_flag, pave_text_flag>{} :{
+                return fill( make_image< configuration< frame1d, graph, pave_text > >(), std::move(content) ).retrieve_content();
+            }
+            case flag_set<graph_flag>{} :{
+                return fill( make_image< configuration< frame1d, graph > >(), std::move(content) ).retrieve_content();
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << " in " << config_file_p << '\n';
+                return {};
+            }
+        }
+    }
+    
+    
+    std::string configurator::generate( std::string const& config_file_p,
+                                        std::string const& function_name_p ) const
+    {
+        auto content = read(config_file_p);
+        
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:{
+                auto config = fill( make_image< configuration< frame1d, histogram1d, legend, pave_text > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<hist1d_flag, legend_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, histogram1d, legend > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<hist1d_flag, pave_text_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, histogram1d, pave_text > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<hist1d_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, histogram1d > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<graph_flag, legend_flag, pave_text_flag>{}:{
+                auto config = fill( make_image< configuration< frame1d, graph, legend, pave_text > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<graph_flag, legend_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph, legend > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<graph_flag, pave_text_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph, pave_text > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            case flag_set<graph_flag>{} :{
+                auto config = fill( make_image< configuration< frame1d, graph > >(), std::move(content) );
+                return generate_code( config, function_name_p, config_file_p );
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return {};
+            }
+        }
+    }
+    
+    
+    namespace {
+        bool holds_hist1d( std::string const& class_name_p ) {
+            auto * class_h = TClass::GetClass( class_name_p.c_str() );
+            return class_h && class_h->InheritsFrom( TH1D::Class() );
+        }
+        
+        render_plan::binding planned( std::string const& name_p, TFile* file_ph, key_entry const& entry_p ) {
+            return { name_p, std::string{ file_ph->GetName() } + ':' + entry_p.path,
+                     entry_p.object_length / static_cast<long long>( sizeof(double) ), entry_p.stored_length };
+        }
+        
+        render_plan::binding planned( std::string const& name_p, TDirectory* directory_ph, TH1D const* hist_ph ) {
+            return { name_p, std::string{ directory_ph->GetName() } + '/' + hist_ph->GetName(), hist_ph->GetNcells(), 0 };
+        }
+    }
+    
+    render_plan configurator::plan( std::string const& config_file_p,
+                                    std::string const& hist_list_p,
+                                    lookup_context const& context_p ) const
+    {
+        render_plan result;
+        result.config_file = config_file_p;
+        
+        auto content = read(config_file_p);
+        switch (content.opcode) {
+            case flag_set<hist1d_flag, legend_flag, pave_text_flag>{}:
+            case flag_set<hist1d_flag, legend_flag>{} :
+            case flag_set<hist1d_flag, pave_text_flag>{} :
+            case flag_set<hist1d_flag>{} :{
+                result.known_configuration = true;
+                break;
+            }
+            default:{
+                std::cerr << "Unknown configuration: " << int(content.opcode) << '\n';
+                return result;
+            }
+        }
+        
+        std::vector<std::string> pattern_c;
+        {
+            monotonic_arena arena;
+            arena_scope scope{ arena };
+            auto config = fill( make_image< configuration< frame1d, histogram1d > >(), std::move(content) );
+            for( auto const& selector_field : config.retrieve_element<histogram1d>().retrieve_column<selector>() ){
+                auto const& pattern = selector_field.retrieve().value();
+                if( pattern.empty() ){ ++result.entry_count; }
+                else{ pattern_c.emplace_back( pattern.begin(), pattern.end() ); }
+            }
+        }
+        
+        auto const name_c = regex_split( hist_list_p, std::regex{"[^;]+"} );
+        result.listed_count = name_c.size();
+        
+        root_guard guard{ root_mutex() };
+        
+        //as find() takes them: every in-memory object of that name, then the first key of that name in each file
+        for( auto const& name : name_c ){
+            std::vector<render_plan::binding> found_c;
+            std::vector<std::string> candidate_c;
+            
+            if( context_p.directory_h ){
+                for( auto * object_h : *context_p.directory_h->GetList() ){
+                    if( name != object_h->GetName() ){ continue; }
+                    candidate_c.push_back( std::string{ context_p.directory_h->GetName() } + '/' + name );
+                    auto * hist_h = dynamic_cast<TH1D*>( object_h );
+                    if( !hist_h ){ result.mistyped_c.push_back( name + ": " + object_h->ClassName() ); continue; }
+                    found_c.push_back( planned( name, context_p.directory_h, hist_h ) );
+                }
+            }
+            
+            for( auto * file_h : context_p.file_c ){
+                auto const index_h = key_index::of( file_h );
+                auto entry_c = name.find('/') != std::string::npos ? std::vector<key_entry const*>{ index_h->find_path( name ) } :
+                                                                     index_h->find_name( name );
+                entry_c.erase( std::remove( entry_c.begin(), entry_c.end(), nullptr ), entry_c.end() );
+                if( entry_c.empty() ){ continue; }
+                
+                for( auto const * entry_h : entry_c ){ candidate_c.push_back( std::string{ file_h->GetName() } + ':' + entry_h->path ); }
+                if( !holds_hist1d( entry_c.front()->class_name ) ){
+                    result.mistyped_c.push_back( name + ": " + entry_c.front()->class_name );
+                    continue;
+                }
+                found_c.push_back( planned( name, file_h, *entry_c.front() ) );
+            }
+            
+            if( candidate_c.empty() ){ result.missing_c.push_back( name ); }
+            if( candidate_c.size() > 1 ){
+                std::string ambiguous{ name + ":" };
+                for( auto const& candidate : candidate_c ){ ambiguous += (ambiguous.back() == ':' ? " " : ", ") + candidate; }
+                result.ambiguous_c.push_back( std::move(ambiguous) );
+            }
+            result.binding_c.insert( result.binding_c.end(), found_c.begin(), found_c.end() );
+        }
+        
+        if( pattern_c.empty() ){ return result; }
+        
+        //as find() with the selectors: in-memory objects, then every key matched on its name or its path
+        selector_set const selector_c{ pattern_c };
+        std::vector<bool> matched_c( pattern_c.size(), false );
+        if( context_p.directory_h ){
+            for( auto * object_h : *context_p.directory_h->GetList() ){
+                auto index = selector_c.match( object_h->GetName() );
                 auto * hist_h = dynamic_cast<TH1D*>( object_h );
-                if(hist_h){ result_c.push_back( hist_h ); }
+                if( index == selector_set::no_match || !hist_h ){ continue; }
+                matched_c[index] = true;
+                result.binding_c.push_back( planned( pattern_c[index], context_p.directory_h, hist_h ) );
+            }
+        }
+        for( auto * file_h : context_p.file_c ){
+            auto const index_h = key_index::of( file_h );
+            for( auto const& entry : index_h->entries() ){
+                auto index = selector_c.match( entry.name() );
+                if( index == selector_set::no_match && entry.path.find('/') != std::string::npos ){
+                    index = selector_c.match( entry.path );
+                }
+                if( index == selector_set::no_match || !holds_hist1d( entry.class_name ) ){ continue; }
+                matched_c[index] = true;
+                result.binding_c.push_back( planned( pattern_c[index], file_h, entry ) );
             }
         }
+        for( std::size_t i{0} ; i < pattern_c.size() ; ++i ){
+            if( !matched_c[i] ){ result.unmatched_c.push_back( pattern_c[i] ); }
+        }
         
-        //gROOT->GetListOfFiles()
-        auto& file_c = *gROOT->GetListOfFiles();
-        for( auto * file_h : file_c ){
-            auto & key_c = *dynamic_cast<TFile*>(file_h)->GetListOfKeys();
-            for( auto* key_h : key_c ){
-                std::cout << "current_key: " << key_h->GetName() << '\n';
+        return result;
+    }
+    
+    
+    //will probably need reverse switch to get mask out and call proper find with th2
+    //or base on configuration ?
+    std::vector<TH1D*> configurator::find( std::vector<std::string> && hist_p, lookup_context const& context_p ) const {
+        std::vector<TH1D*> result_c;
+        root_guard guard{ root_mutex() };
+        
+        //current directory first, then look in registered files
+        if( context_p.directory_h ){
+            std::cout << "directory: " << context_p.directory_h->GetName() << '\n';
+            auto& object_c = *context_p.directory_h->GetList();
+            for( auto * object_h : object_c ){
+                std::cout << "Current object: " << object_h->GetName() << '\n';
                 auto hist_i = std::find_if(
-                                           hist_p.begin(), hist_p.end(),
-                                           [&key_h]( std::string const& name_p )
-                                           { return name_p == std::string{ key_h->GetName() }; }
+                                    hist_p.begin(), hist_p.end(),
+                                    [&object_h]( std::string const& name_p )
+                                    { return name_p == std::string{ object_h->GetName() }; }
                                            );
                 if( hist_i != hist_p.end() ){
-                    auto * hist_h = dynamic_cast<TH1D*>( dynamic_cast<TKey*>(key_h)->ReadObj() );
+                    auto * hist_h = dynamic_cast<TH1D*>( object_h );
                     if(hist_h){ result_c.push_back( hist_h ); }
                 }
             }
         }
         
+        //names holding a '/' are paths inside the file, plain names are looked for in every directory
+        for( auto * file_h : context_p.file_c ){
+            auto const index_h = key_index::of( file_h );
+            for( auto const& name : hist_p ){
+                auto const * entry_h = index_h->resolve( name );
+                if( !entry_h ){ continue; }
+                auto * hist_h = dynamic_cast<TH1D*>( read_object( file_h, *entry_h ) );
+                if(hist_h){ result_c.push_back( hist_h ); }
+            }
+        }
+        
         
         return result_c;
     }
 
 
     
-    configurator::formatted_content configurator::read( std::string config_file_p ) const {
-        std::ifstream input{ config_file_p };
-        if( !input.is_open() ){
-            std::cerr << "Could not open file: " << config_file_p << "\n";
-            return {};
-        }
+    std::vector<TGraph*> configurator::find_graphs( std::vector<std::string> const& name_pc,
+                                                    lookup_context const& context_p ) const {
+        std::vector<TGraph*> result_c;
+        result_c.reserve( name_pc.size() );
+        root_guard guard{ root_mutex() };
         
-        std::string file_content;
-        input.seekg(0, std::ios::end);
-        file_content.reserve(input.tellg());
-        input.seekg(0, std::ios::beg);
+        //graphs are not attached to directories by ROOT: those in memory have been appended to it by the user
+        for( auto const& name : name_pc ){
+            TGraph * graph_h{nullptr};
+            if( context_p.directory_h ){
+                for( auto * object_h : *context_p.directory_h->GetList() ){
+                    if( name == object_h->GetName() ){ graph_h = dynamic_cast<TGraph*>( object_h ); }
+                    if( graph_h ){ break; }
+                }
+            }
+            for( auto file_i = context_p.file_c.begin() ; !graph_h && file_i != context_p.file_c.end() ; ++file_i ){
+                auto const index_h = key_index::of( *file_i );
+                auto const * entry_h = index_h->resolve( name );
+                if( entry_h ){ graph_h = dynamic_cast<TGraph*>( read_object( *file_i, *entry_h ) ); }
+            }
+            
+            if( graph_h ){ result_c.push_back( graph_h ); }
+            else{ std::cerr << "Graph not found: " << name << '\n'; }
+        }
         
-        file_content.assign( std::istreambuf_iterator<char>(input),
-                             std::istreambuf_iterator<char>() );
+        return result_c;
+    }
+    
+    
+    std::vector< std::pair<int, TH1D*> > configurator::find( selector_set const& selector_p,
+                                                             lookup_context const& context_p ) const {
+        std::vector< std::pair<int, TH1D*> > result_c;
+        root_guard guard{ root_mutex() };
         
+        if( context_p.directory_h ){
+            for( auto * object_h : *context_p.directory_h->GetList() ){
+                auto index = selector_p.match( object_h->GetName() );
+                if( index == selector_set::no_match ){ continue; }
+                auto * hist_h = dynamic_cast<TH1D*>( object_h );
+                if(hist_h){ result_c.emplace_back( index, hist_h ); }
+            }
+        }
         
-        auto user_text_c = regex_split( file_content,
-                                         std::regex("\\[(.|\\n)*?\\]"));
-        for(const auto& user_text : user_text_c){
-            file_content.erase( file_content.find(user_text),
-                                user_text.size());
+        //keys of every directory, matched on their name first then on their path
+        for( auto * file_h : context_p.file_c ){
+            auto const index_h = key_index::of( file_h );
+            for( auto const& entry : index_h->entries() ){
+                auto index = selector_p.match( entry.name() );
+                if( index == selector_set::no_match && entry.path.find('/') != std::string::npos ){
+                    index = selector_p.match( entry.path );
+                }
+                if( index == selector_set::no_match ){ continue; }
+                auto * hist_h = dynamic_cast<TH1D*>( read_object( file_h, entry ) );
+                if(hist_h){ result_c.emplace_back( index, hist_h ); }
+            }
         }
         
-        file_content.erase(
-                std::remove_if( file_content.begin(),
-                                file_content.end(),
-                                [](unsigned char c){
-                                    return std::isspace(c);
-                                    
-                                } ),
-                file_content.end()
-                          );
+        return result_c;
+    }
+
+
+    
+    namespace {
+        std::string read_file( std::string const& config_file_p ) {
+            std::ifstream input{ config_file_p };
+            if( !input.is_open() ){
+                //<bundle>#<entry>, see bundle.hpp
+                auto const separator = config_file_p.rfind( '#' );
+                if( separator != std::string::npos ){
+                    return read_bundle_entry( config_file_p.substr( 0, separator ), config_file_p.substr( separator + 1 ) );
+                }
+                std::cerr << "Could not open file: " << config_file_p << "\n";
+                return {};
+            }
+            
+            std::string file_content;
+            input.seekg(0, std::ios::end);
+            file_content.reserve(input.tellg());
+            input.seekg(0, std::ios::beg);
+            
+            file_content.assign( std::istreambuf_iterator<char>(input),
+                                 std::istreambuf_iterator<char>() );
+            return file_content;
+        }
         
+        //position of the closing tag, user texts being skipped as they may hold anything
+        std::size_t find_closing_tag( std::string const& content_p, std::string const& tag_p, std::size_t position_p ) {
+            while( (position_p = content_p.find_first_of( "[<", position_p )) != std::string::npos ){
+                if( content_p[position_p] == '[' ){
+                    position_p = content_p.find( ']', position_p );
+                    if( position_p == std::string::npos ){ break; }
+                    ++position_p;
+                    continue;
+                }
+                if( content_p.compare( position_p, tag_p.size(), tag_p ) == 0 ){ return position_p; }
+                ++position_p;
+            }
+            return std::string::npos;
+        }
         
-        std::size_t position{0};
-        for(const auto& user_text : user_text_c){
-            position = file_content.find( "user_text:=", position );
-            if( position != std::string::npos ){
-                file_content.insert(
-                            position + std::string{"user_text:="}.size(),
-                            user_text
-                                    );
+        //calls action_p with the tag, beginning and end of each top level block, found on their tags alone
+        template<class Action>
+        void scan_blocks( std::string const& content_p, Action action_p ) {
+            std::size_t position{0};
+            while( (position = content_p.find( '<', position )) != std::string::npos ){
+                auto const tag_end = content_p.find( '>', position );
+                if( tag_end == std::string::npos ){ break; }
+                auto const tag = content_p.substr( position, tag_end + 1 - position );
+                
+                auto const closing = find_closing_tag( content_p, tag, tag_end + 1 );
+                if( closing == std::string::npos ){ break; }
+                
+                auto const block_end = closing + tag.size();
+                action_p( tag, position, block_end );
+                position = block_end;
             }
-            position += std::string{"user_text:="}.size();
         }
-
         
-        auto element_c = regex_split( file_content, std::regex{"<(\\w+)\\b>(.|\\n)*?<\\1>"} );
+        std::vector<std::string> select_blocks( std::string const& content_p, std::vector<std::string> const& tag_pc ) {
+            std::vector<std::string> result_c;
+            scan_blocks( content_p, [&]( std::string const& tag_p, std::size_t begin_p, std::size_t end_p ){
+                if( std::find( tag_pc.begin(), tag_pc.end(), tag_p ) != tag_pc.end() ){
+                    result_c.push_back( content_p.substr( begin_p, end_p - begin_p ) );
+                }
+            } );
+            return result_c;
+        }
+        
+        uint8_t opcode_of( std::string const& tag_p ) {
+            if( tag_p == "<legend>"    ){ return flag_set<legend_flag>{}; }
+            if( tag_p == "<pave_text>" ){ return flag_set<pave_text_flag>{}; }
+            if( tag_p == "<hist1d>"    ){ return flag_set<hist1d_flag>{}; }
+            if( tag_p == "<graph>"     ){ return flag_set<graph_flag>{}; }
+            return 0;
+        }
+    }
+    
+    
+    std::string configurator::normalize( std::string file_content ) const {
+        strip_whitespace( file_content );
+        return file_content;
+    }
+    
+    std::vector<std::string> configurator::split_elements( std::string const& content_p ) const {
+        return regex_split( content_p, std::regex{"<(\\w+)\\b>(.|\\n)*?<\\1>"} );
+    }
+    
+    std::string configurator::cache_key( std::uint64_t content_hash_p, std::uint64_t type_hash_p ) {
+        char key[40];
+        std::snprintf( key, sizeof(key), "%016llx-%016llx",
+                       static_cast<unsigned long long>( content_hash_p ), static_cast<unsigned long long>( type_hash_p ) );
+        return key;
+    }
+    
+    configurator::formatted_content configurator::read( std::string config_file_p ) const {
+        auto file_content = read_file( config_file_p );
+        
+        //the tags are enough to pick the configuration, parsing is left to the cache
+        if( image_cache::node() && !file_content.empty() ){
+            uint8_t opcode {0};
+            scan_blocks( file_content, [&opcode]( std::string const& tag_p, std::size_t, std::size_t ){ opcode |= opcode_of( tag_p ); } );
+            auto const hash = image_cache::hash( file_content );
+            return { opcode, {}, hash, std::move(file_content) };
+        }
+        
+        auto element_c = split_elements( normalize( std::move(file_content) ) );
         uint8_t opcode {0};
 
         for( auto const& element : element_c ){
-            auto tag = regex_first_match( element, std::regex{"<[^<>]+>"} );
-            if( tag == "<legend>"    ){ opcode |= flag_set<legend_flag>{};}
-            if( tag == "<pave_text>" ){ opcode |= flag_set<pave_text_flag>{}; }
-            if( tag == "<hist1d>"    ){ opcode |= flag_set<hist1d_flag>{}; }
+            opcode |= opcode_of( regex_first_match( element, std::regex{"<[^<>]+>"} ) );
         }
 
         return { opcode, std::move( element_c ) };
     }
+    
+    configurator::formatted_content configurator::read( std::string config_file_p, uint8_t element_mask_p ) const {
+        auto tag_of = []( std::string const& anchor_p ){ return "<" + anchor_p + ">"; };
+        
+        std::vector<std::string> tag_c;
+        if( element_mask_p & flag_set<pad_flag>{} ){ tag_c.push_back( tag_of( std::string{ pad::anchor } ) ); }
+        if( element_mask_p & flag_set<frame_flag>{} ){ tag_c.push_back( tag_of( std::string{ frame1d::anchor } ) ); }
+        if( element_mask_p & (flag_set<hist1d_flag>{} | flag_set<legend_flag>{}) ){ tag_c.push_back( tag_of( std::string{ histogram1d::anchor } ) ); }
+        if( element_mask_p & flag_set<legend_flag>{} ){ tag_c.push_back( tag_of( std::string{ legend::anchor } ) ); }
+        if( element_mask_p & flag_set<pave_text_flag>{} ){ tag_c.push_back( tag_of( std::string{ pave_text::anchor } ) ); }
+        
+        std::vector<std::string> element_c;
+        for( auto& block : select_blocks( read_file( config_file_p ), tag_c ) ){ element_c.push_back( normalize( std::move(block) ) ); }
+        return { element_mask_p, std::move( element_c ) };
+    }
 
 
 }//namespace iwir
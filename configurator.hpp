@@ -9,15 +9,29 @@
 #define configurator_hpp
 
 #include "configuration_image.hpp"
+#include "downsampling.hpp"
+#include "shared_image.hpp"
+#include "image_cache.hpp"
+#include "image_codec.hpp"
+#include "plan.hpp"
+#include "root_context.hpp"
+#include "selector.hpp"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <regex>
+#include <algorithm>
+#include <functional>
+#include <memory>
 
 #include "TH1.h"
 #include "TCanvas.h"
+#include "TGraph.h"
 #include "TPaveText.h"
 #include "TLegend.h"
+#include "TLegendEntry.h"
+#include "TText.h"
 
 namespace iwir {
     
@@ -28,21 +42,203 @@ namespace iwir {
     std::string remove_outer_tag( std::string text_p );
     double regex_arithmetic_value( std::string const & text_p, std::regex regex_p );
     
+    //canvas drawn by configurator::apply_tracked, kept together with the configuration it was drawn from
+    struct applied_configuration {
+        virtual ~applied_configuration() = default;
+        
+        TCanvas* canvas_h{nullptr};
+        uint8_t opcode{0};
+    };
+    
+    template<class Configuration>
+    struct applied_image : applied_configuration {
+        explicit applied_image( shared_image<Configuration> image_p ) : image{ std::move(image_p) } {}
+        shared_image<Configuration> image;
+    };
+    
     struct configurator {
         struct formatted_content {
             uint8_t opcode;
             std::vector<std::string> element_c;
+            //with the node cache enabled (see image_cache.hpp): the file as it is and its hash, element_c being left empty,
+            //as it is only parsed when no process of the node did already
+            std::uint64_t hash{0};
+            std::string raw_content;
         };
         
         
+        //configuration read and filled once, drawing a new canvas for each list of histograms it is given
+        using applier = std::function< TCanvas*( std::vector<TH1D*>&& ) >;
+        //same, for the style-only apply: histograms are numbered from the given index when picking their entry
+        using styler = std::function< void( std::vector<TH1*> const&, std::size_t ) >;
+        
     public:
         void operator()( std::string const& config_file_p, std::string const& hist_list_p ) const;
         
+        //histograms are only looked for in the given context, the configuration is read and filled outside of the ROOT lock
+        void operator()( std::string const& config_file_p,
+                         std::string const& hist_list_p,
+                         lookup_context const& context_p ) const;
+        
+        applier prepare( std::string const& config_file_p ) const;
+        
+        //marker, line and axis attributes only: no canvas, no drawing, the i-th histogram takes the i-th entry modulo their number
+        void apply_style( std::string const& config_file_p, std::vector<TH1*> const& hist_pc ) const;
+        
+        styler prepare_style( std::string const& config_file_p ) const;
+        
+        //same as operator(), the filled image being kept for later updates
+        //the given canvas is cleared and drawn again, a new one is created when nullptr
+        std::unique_ptr<applied_configuration> apply_tracked( std::string const& config_file_p,
+                                                              std::string const& hist_list_p,
+                                                              TCanvas* canvas_ph = nullptr ) const;
+        
+        //compares the configuration with the one applied last, field by field, and only issues the Set* calls
+        //for what changed, followed by a single Update()
+        //false, leaving the canvas untouched, when it cannot be done in place: other elements or number of entries,
+        //other drawing options, selectors
+        bool update( applied_configuration& applied_p, std::string const& config_file_p ) const;
+        
+        //configuration read and filled once, for update to apply it to every canvas drawn from that file
+        //its canvas_h is left nullptr, nullptr itself when the configuration cannot be read
+        std::unique_ptr<applied_configuration> parse( std::string const& config_file_p ) const;
+        
+        //same as above from a parsed configuration, whose image the updated canvas then shares
+        bool update( applied_configuration& applied_p, applied_configuration const& parsed_p ) const;
+        
+        //applies only the elements of element_mask_p (flag_set of pad_flag, frame_flag, hist1d_flag, legend_flag, pave_text_flag)
+        //onto a canvas drawn by apply: pad, frame and histograms are restyled in place, legend and pave texts replaced
+        //only the blocks of those elements are parsed, the others are skipped on their tag alone
+        //(the legend also needs the hist1d blocks, holding its entries)
+        void apply_elements( std::string const& config_file_p, uint8_t element_mask_p, TCanvas* canvas_ph ) const;
+        
+        //dry run of operator(): the configuration is read, and the listed names and selectors resolved through the key
+        //indexes of the context, without reading any histogram nor drawing anything
+        render_plan plan( std::string const& config_file_p,
+                          std::string const& hist_list_p,
+                          lookup_context const& context_p ) const;
+        
+        //configuration read, filled and written back out as saver writes it: files differing only in their layout
+        //give the same content, empty when the configuration cannot be read
+        std::string reformat( std::string const& config_file_p ) const;
+        
+        //header building the image of the configuration entry by entry, with no parsing left at run time (see codegen.hpp)
+        std::string generate( std::string const& config_file_p, std::string const& function_name_p ) const;
+        
+        //applies an already filled image (plain, shared or overlaid) to the histograms
+        template<class Image>
+        void operator()( Image const& image_p, std::string const& hist_list_p ) const {
+            using holds_graph = std::integral_constant< bool, holds_element<graph>( typename Image::configuration_type{} ) >;
+            apply_image( image_p, regex_split(hist_list_p, std::regex{"[^;]+"} ), holds_graph{} );
+        }
+        
+        //reads the configuration once, to be shared by every canvas it is applied to
+        template<class ... Ts>
+        shared_image< configuration<Ts...> > load( std::string const& config_file_p ) const {
+            return share< Ts... >( read( config_file_p ) );
+        }
+        
     private:
-        std::vector<TH1D*> find( std::vector<std::string> && hist_p ) const ;
+        template<class Image>
+        void apply_image( Image const& image_p, std::vector<std::string>&& name_pc, std::false_type ) const {
+            apply( image_p, find( std::move(name_pc), lookup_context::current() ) );
+        }
+        
+        template<class Image>
+        void apply_image( Image const& image_p, std::vector<std::string>&& name_pc, std::true_type ) const {
+            apply_graphs( image_p, find_graphs( name_pc, lookup_context::current() ) );
+        }
+        
+        template<class ... Ts>
+        shared_image< configuration<Ts...> > share( formatted_content content_p ) const {
+            monotonic_arena arena;
+            arena_scope scope{ arena };
+            auto config = fill( make_image< configuration<Ts...> >(), std::move(content_p) );
+            return shared_image< configuration<Ts...> >{ config };
+        }
+        
+        template<class Image>
+        applier make_applier( Image image_p, std::string const& config_file_p ) const {
+            if( carries_selector( image_p, config_file_p ) ){ return {}; }
+            return [image_p]( std::vector<TH1D*>&& hist_pc ){ return configurator{}.apply( image_p, std::move(hist_pc) ); };
+        }
+        
+        //prepared appliers and stylers take their histograms by position, selectors needing the lookup done by apply
+        template<class Image>
+        bool carries_selector( Image const& image_p, std::string const& config_file_p ) const {
+            auto const& selector_c = image_p.template retrieve_element<histogram1d>().template retrieve_column<selector>();
+            for( auto const& selector_field : selector_c ){
+                if( selector_field.retrieve().value().empty() ){ continue; }
+                std::cerr << "Selectors cannot be prepared, apply the configuration instead: " << config_file_p << '\n';
+                return true;
+            }
+            return false;
+        }
+        
+    private:
+        //lookups run under the ROOT lock, the files of the context being possibly shared with other threads
+        std::vector<TH1D*> find( std::vector<std::string> && hist_p, lookup_context const& context_p ) const ;
+        
+        //names looked for in turn, in memory first then in the files
+        std::vector<TGraph*> find_graphs( std::vector<std::string> const& name_pc, lookup_context const& context_p ) const ;
+        
+        //draws a configuration holding graphs, nothing being drawn for other ones
+        void draw_graphs( formatted_content content_p, std::vector<std::string> const& name_pc, lookup_context const& context_p ) const ;
+        
+        //one pass over every reachable object name, each histogram is paired with the index of the first matching selector
+        std::vector< std::pair<int, TH1D*> > find( selector_set const& selector_p, lookup_context const& context_p ) const ;
+        
+        //entries carrying a selector are duplicated for every histogram they match, appended after the positional ones
+        template< class ... Ts >
+        std::vector<TH1D*> bind( image< configuration<Ts...> >& image_p,
+                                 std::vector<TH1D*>&& listed_pc,
+                                 lookup_context const& context_p ) const {
+            auto & hist_element = image_p.template retrieve_element<histogram1d>();
+            auto const& selector_c = hist_element.template retrieve_column<selector>();
+            
+            std::vector<std::string> pattern_c;
+            std::vector<std::size_t> owner_c;
+            std::vector<std::size_t> positional_c;
+            for( std::size_t i{0} ; i < selector_c.size() ; ++i ){
+                auto const& pattern = selector_c[i].retrieve().value();
+                if( pattern.empty() ){ positional_c.push_back( i ); continue; }
+                pattern_c.emplace_back( pattern.begin(), pattern.end() );
+                owner_c.push_back( i );
+            }
+            //matched in order, the surplus on either side being left out, as plan() reports beforehand
+            if( listed_pc.size() != positional_c.size() ){
+                std::cerr << listed_pc.size() << " histograms found for " << positional_c.size()
+                          << " positional hist1d entries, only the first " << std::min( listed_pc.size(), positional_c.size() )
+                          << " are matched\n";
+            }
+            if( pattern_c.empty() ){ return std::move(listed_pc); }
+            
+            columnar_value_element<histogram1d> bound_element;
+            std::vector<TH1D*> result_c;
+            
+            auto const positional_count = std::min( positional_c.size(), listed_pc.size() );
+            for( std::size_t i{0} ; i < positional_count ; ++i ){
+                bound_element.add_copy( hist_element, positional_c[i] );
+                result_c.push_back( listed_pc[i] );
+            }
+            
+            for( auto const& match : find( selector_set{ pattern_c }, context_p ) ){
+                auto entry = bound_element.add_copy( hist_element, owner_c[ match.first ] );
+                entry.template retrieve_field<name>().template fill<plain_text>( match.second->GetName() );
+                result_c.push_back( match.second );
+            }
+            
+            hist_element = std::move( bound_element );
+            return result_c;
+        }
         
     private:
         formatted_content read( std::string config_file_p ) const;
+        //same, keeping only the blocks of the elements in the mask
+        formatted_content read( std::string config_file_p, uint8_t element_mask_p ) const;
+        //user texts kept as they are, everything else stripped of whitespace
+        std::string normalize( std::string content_p ) const;
+        std::vector<std::string> split_elements( std::string const& content_p ) const;
         
         
         
@@ -53,6 +249,26 @@ namespace iwir {
         };
         
     private:
+        template< class ... Ts>
+        image< configuration<Ts...> > fill( image< configuration<Ts...> >&& image_p,
+                                            formatted_content content_p ) const {
+            if( content_p.raw_content.empty() ){ return fill( std::move(image_p), std::move(content_p.element_c) ); }
+            
+            auto parse = [this, &content_p](){ return split_elements( normalize( content_p.raw_content ) ); };
+            auto const key = cache_key( content_p.hash, image_cache::hash( image_signature< configuration<Ts...> >::value() ) );
+            auto blob_h = image_cache::node()->find_or_build( key, [this, &parse](){
+                monotonic_arena arena;
+                arena_scope scope{ arena };
+                return encode( fill( make_image< configuration<Ts...> >(), parse() ) );
+            } );
+            if( blob_h && decode( image_p, blob_h->data(), blob_h->size() ) ){ return std::move(image_p); }
+            
+            //the image may hold part of a foreign blob
+            return fill( make_image< configuration<Ts...> >(), parse() );
+        }
+        
+        static std::string cache_key( std::uint64_t content_hash_p, std::uint64_t type_hash_p );
+        
         template< class ... Ts>
         image< configuration<Ts...> > fill( image< configuration<Ts...> >&& image_p,
                                             std::vector<std::string> element_content_pc ) const {
@@ -126,12 +342,12 @@ namespace iwir {
             for( auto const& entry : entry_c) {
                 auto name = regex_first_match( entry, std::regex{"[^:=]+"} );
                 if( name == "low" ){
-                    auto value = regex_arithmetic_value( entry, std::regex{"([0-9]|\\.)+"} );
+                    auto value = regex_arithmetic_value( entry, std::regex{"-?([0-9]|\\.)+"} );
                     range_p.template fill<low>( value );
                 }
                 
                 if( name == "high"){
-                    auto value = regex_arithmetic_value( entry, std::regex{"([0-9]|\\.)+"} );
+                    auto value = regex_arithmetic_value( entry, std::regex{"-?([0-9]|\\.)+"} );
                     range_p.template fill<high>( value );
                 }
             }
@@ -197,6 +413,20 @@ namespace iwir {
             }
         }
         
+        template<class T>
+        void fill_selector( T & selector_p, std::vector<std::string> const& entry_c ) const {
+            for( auto const& entry : entry_c) {
+                auto name = regex_first_match( entry, std::regex{"[^:=]+"} );
+                
+                if( name == "user_text"){
+                    std::string content = entry;
+                    content.erase( content.find(name), name.size() +2 );
+                    auto value = regex_first_match( content, std::regex{"[^\\[\\]]+"} );
+                    selector_p.template fill<user_text>( value );
+                }
+            }
+        }
+        
         template<class T>
         void fill_legend_attributes( T & header_p, std::vector<std::string> const& entry_c ) const {
             for( auto const& entry : entry_c) {
@@ -346,12 +576,16 @@ namespace iwir {
         image< configuration<Ts...> > fill_element_impl( image< configuration<Ts...> >&& image_p,
                                                         std::vector<std::string>&& field_pc,
                                                         histogram1d ) const {
-            auto& hist_element = image_p.template retrieve_element<histogram1d>().add_value();
+            auto hist_element = image_p.template retrieve_element<histogram1d>().add_value();
             for(auto const& field : field_pc) {
                 std::string entries = remove_outer_tag(field);
                 auto entry_c = regex_split(entries, std::regex{"[^;]+"} );
                 
                 auto field_name = regex_first_match( field, std::regex{"[^<>]+"} );
+                if( field_name == "selector" ){
+                    auto & selector_field = hist_element.template retrieve_field<selector>();
+                    fill_selector( selector_field, entry_c );
+                }
                 if( field_name == "legend_attributes" ){
                     auto & attributes_field = hist_element.template retrieve_field<legend_attributes>();
                     fill_legend_attributes( attributes_field, entry_c );
@@ -372,6 +606,40 @@ namespace iwir {
             return std::move( image_p );
         }
         
+        template< class ... Ts >
+        image< configuration<Ts...> > fill_element_impl( image< configuration<Ts...> >&& image_p,
+                                                        std::vector<std::string>&& field_pc,
+                                                        graph ) const {
+            auto& graph_element = image_p.template retrieve_element<graph>().add_value();
+            for(auto const& field : field_pc) {
+                std::string entries = remove_outer_tag(field);
+                auto entry_c = regex_split(entries, std::regex{"[^;]+"} );
+                
+                auto field_name = regex_first_match( field, std::regex{"[^<>]+"} );
+                if( field_name == "legend_attributes" ){
+                    auto & attributes_field = graph_element.template retrieve_field<legend_attributes>();
+                    fill_legend_attributes( attributes_field, entry_c );
+                }
+                if( field_name == "option" ){
+                    auto & option_field = graph_element.template retrieve_field<option>();
+                    fill_option( option_field, entry_c );
+                }
+                if( field_name == "marker" ){
+                    auto & marker_field = graph_element.template retrieve_field<marker>();
+                    fill_marker( marker_field, entry_c );
+                }
+                if( field_name == "line" ){
+                    auto & line_field = graph_element.template retrieve_field<line>();
+                    fill_line( line_field, entry_c );
+                }
+                if( field_name == "sampling" ){
+                    auto & sampling_field = graph_element.template retrieve_field<sampling>();
+                    fill_option( sampling_field, entry_c );
+                }
+            }
+            return std::move( image_p );
+        }
+        
         template< class ... Ts >
         image< configuration<Ts...> > fill_element_impl( image< configuration<Ts...> >&& image_p,
                                                         std::vector<std::string>&& field_pc,
@@ -430,18 +698,84 @@ namespace iwir {
 
         
         
+        ///-------------------style-----------------------
+    private:
+        template< class Image >
+        void apply_style_impl( Image const& image_p,
+                               std::vector<TH1*> const& hist_pc,
+                               std::size_t first_index_p = 0 ) const {
+            
+            auto const& frame_element = image_p.template retrieve_element<frame1d>();
+            auto const& title_x = frame_element.template retrieve_field< title<x> >().retrieve();
+            auto const& label_x = frame_element.template retrieve_field< label<x> >().retrieve();
+            auto const& title_y = frame_element.template retrieve_field< title<y> >().retrieve();
+            auto const& label_y = frame_element.template retrieve_field< label<y> >().retrieve();
+            auto const title_x_text = title_x.user_data();
+            auto const title_y_text = title_y.user_data();
+            
+            auto const& hist_element = image_p.template retrieve_element<histogram1d>();
+            auto const& marker_c = hist_element.template retrieve_column<marker>();
+            auto const& line_c = hist_element.template retrieve_column<line>();
+            auto const entry_count = hist_element.size();
+            
+            for( std::size_t i{0} ; i < hist_pc.size() ; ++i ){
+                auto * hist_h = hist_pc[i];
+                
+                auto * axis_x_h = hist_h->GetXaxis();
+                axis_x_h->SetTitle( title_x_text.c_str() );
+                axis_x_h->SetTitleSize( title_x.size );
+                axis_x_h->SetTitleOffset( title_x.offset );
+                axis_x_h->SetLabelSize( label_x.size );
+                axis_x_h->SetLabelOffset( label_x.offset );
+                
+                auto * axis_y_h = hist_h->GetYaxis();
+                axis_y_h->SetTitle( title_y_text.c_str() );
+                axis_y_h->SetTitleSize( title_y.size );
+                axis_y_h->SetTitleOffset( title_y.offset );
+                axis_y_h->SetLabelSize( label_y.size );
+                axis_y_h->SetLabelOffset( label_y.offset );
+                
+                if( !entry_count ){ continue; }
+                auto const index = (first_index_p + i) % entry_count;
+                
+                auto const& marker_field = marker_c[index].retrieve();
+                hist_h->SetMarkerStyle( marker_field.style );
+                hist_h->SetMarkerSize( marker_field.size );
+                hist_h->SetMarkerColor( marker_field.color );
+                
+                auto const& line_field = line_c[index].retrieve();
+                hist_h->SetLineStyle( line_field.style );
+                hist_h->SetLineWidth( line_field.width );
+                hist_h->SetLineColor( line_field.color );
+            }
+        }
+        
+        
         ///-------------------apply-----------------------
     private:
-        template< class ... Ts>
-        void apply( image< configuration<Ts...> >&& image_p,
-                     std::vector<TH1D *>&& hist_pc ) const {
-            apply_element( std::move(image_p), std::move(hist_pc), pad{});
+        template< class Image >
+        TCanvas* apply( Image const& image_p,
+                        std::vector<TH1D *>&& hist_pc,
+                        TCanvas* canvas_ph = nullptr ) const {
+            //the canvas is registered in gROOT and becomes gPad, on which every element is drawn
+            root_guard guard{ root_mutex() };
+            auto * canvas_h = canvas_ph;
+            if( canvas_h ){ canvas_h->Clear(); canvas_h->cd(); }
+            else{ canvas_h = new TCanvas{}; }
+            apply_impl( image_p, std::move(hist_pc), typename Image::configuration_type::elements{} );
+            return canvas_h;
+        }
+        
+        template< class Image, class ... Ts>
+        void apply_impl( Image const& image_p,
+                         std::vector<TH1D *>&& hist_pc,
+                         std::tuple<Ts...> ) const {
             int expander[] = { 0, (apply_element( image_p, std::move(hist_pc), Ts{}), void(), 0) ... };
         }
         
         
-        template< class ... Ts >
-        void apply_element( image< configuration<Ts...> > const& image_p,
+        template< class Image >
+        void apply_element( Image const& image_p,
                              std::vector<TH1D*> const&& /*hist_pc*/,
                              pad ) const {
             
@@ -453,51 +787,55 @@ namespace iwir {
                                           .template retrieve_field<range<y>>()
                                           .retrieve();
             
-            auto * canvas_h = new TCanvas{};
-            
-            canvas_h->SetTopMargin(margin_y.high);
-            canvas_h->SetRightMargin(margin_x.high);
-            canvas_h->SetBottomMargin(margin_y.low);
-            canvas_h->SetLeftMargin(margin_x.low);
+            gPad->SetTopMargin(margin_y.high);
+            gPad->SetRightMargin(margin_x.high);
+            gPad->SetBottomMargin(margin_y.low);
+            gPad->SetLeftMargin(margin_x.low);
         }
         
-        template< class ... Ts >
-        void apply_element( image< configuration<Ts...> > const& image_p,
+        template< class Image >
+        void apply_element( Image const& image_p,
                              std::vector<TH1D *>&& /*hist_pc*/,
                              frame1d ) const {
             
             auto & frame_element = image_p.template retrieve_element<frame1d>();
-            auto * frame_h = new TH1D{"frame","",1,0,1};
-            
-            auto & title_x = frame_element.template retrieve_field< title<x> >().retrieve();
-            frame_h->GetXaxis()->SetTitle( title_x.user_data().c_str() );
-            frame_h->GetXaxis()->SetTitleSize( title_x.size );
-            frame_h->GetXaxis()->SetTitleOffset( title_x.offset );
-            
-            auto & range_x = frame_element.template retrieve_field< range<x> >().retrieve();
-            frame_h->GetXaxis()->SetRangeUser(range_x.low, range_x.high);
-            
-            auto & label_x = frame_element.template retrieve_field< label<x> >().retrieve();
-            frame_h->GetXaxis()->SetLabelSize( label_x.size );
-            frame_h->GetXaxis()->SetLabelOffset( label_x.offset );
+            //never registered in gDirectory, where frames of concurrent applies would replace each other
+            TH1D * frame_h{ nullptr };
+            {
+                TDirectory::TContext context{ nullptr };
+                frame_h = new TH1D{"frame","",1,0,1};
+            }
+            frame_h->SetBit( TObject::kCanDelete );
             
-            auto & title_y = frame_element.template retrieve_field< title<y> >().retrieve();
-            frame_h->GetYaxis()->SetTitle( title_y.user_data().c_str() );
-            frame_h->GetYaxis()->SetTitleSize( title_y.size );
-            frame_h->GetYaxis()->SetTitleOffset( title_y.offset );
+            restyle_axis<x>( frame_element, frame_h->GetXaxis() );
+            restyle_axis<y>( frame_element, frame_h->GetYaxis() );
             
-            auto & range_y = frame_element.template retrieve_field< range<y> >().retrieve();
-            frame_h->GetYaxis()->SetRangeUser( range_y.low, range_y.high  );
+            frame_h->Draw();
+        }
+        
+        template<class Axis, class Element>
+        void restyle_axis( Element const& frame_element_p, TAxis* axis_ph ) const {
+            restyle_axis_text<Axis>( frame_element_p, axis_ph );
             
-            auto & label_y = frame_element.template retrieve_field< label<y> >().retrieve();
-            frame_h->GetYaxis()->SetLabelSize( label_y.size ) ;
-            frame_h->GetYaxis()->SetLabelOffset( label_y.offset );
+            auto const& range_field = frame_element_p.template retrieve_field< range<Axis> >().retrieve();
+            axis_ph->SetRangeUser( range_field.low, range_field.high );
+        }
+        
+        //title and labels
+        template<class Axis, class Element>
+        void restyle_axis_text( Element const& frame_element_p, TAxis* axis_ph ) const {
+            auto const& title_field = frame_element_p.template retrieve_field< title<Axis> >().retrieve();
+            axis_ph->SetTitle( title_field.user_data().c_str() );
+            axis_ph->SetTitleSize( title_field.size );
+            axis_ph->SetTitleOffset( title_field.offset );
             
-            frame_h->Draw();
+            auto const& label_field = frame_element_p.template retrieve_field< label<Axis> >().retrieve();
+            axis_ph->SetLabelSize( label_field.size );
+            axis_ph->SetLabelOffset( label_field.offset );
         }
         
-        template< class ... Ts >
-        void apply_element( image< configuration<Ts...> > const& image_p,
+        template< class Image >
+        void apply_element( Image const& image_p,
                              std::vector<TH1D *>&& /*hist_pc*/,
                              pave_text ) const {
             
@@ -519,18 +857,20 @@ namespace iwir {
                     text_h->SetTextColor( header.color );
                 }
                 
+                pave_text_h->SetBit( TObject::kCanDelete );
                 pave_text_h->Draw("same");
             }
             
         }
         
-        template< class ... Ts >
-        void apply_element( image< configuration<Ts...> > const& image_p,
+        template< class Image >
+        void apply_element( Image const& image_p,
                              std::vector<TH1D*>&& hist_pc,
                              histogram1d ) const {
             
             auto hist_i = hist_pc.begin();
             for( auto const& hist_element : image_p.template retrieve_element<histogram1d>() ) {
+                if( hist_i == hist_pc.end() ){ break; }
                 auto * hist_h = *hist_i;
                 
                 auto const& name_field = hist_element.template retrieve_field< name >().retrieve();
@@ -555,15 +895,38 @@ namespace iwir {
         }
         
         
-        template< class ... Ts >
-        void apply_element( image< configuration<Ts...> > const& image_p,
+        template< class Image >
+        void apply_element( Image const& image_p,
                              std::vector<TH1D*>&& hist_pc,
                              legend ) const {
             
-            auto const& legend_element = image_p.template retrieve_element<legend>();
+            auto * legend_h = make_legend( image_p.template retrieve_element<legend>() );
+            
+            auto hist_i = hist_pc.begin();
+            for( auto const& hist_element : image_p.template retrieve_element<histogram1d>() ) {
+                if( hist_i == hist_pc.end() ){ break; }
+                auto const& name_field = hist_element.template retrieve_field< name >().retrieve();
+                
+                auto const& attributes_field = hist_element.template retrieve_field< legend_attributes >().retrieve();
+                legend_h->AddEntry(
+                                *hist_i,
+                                attributes_field.user_data().c_str() ,
+                                attributes_field.plain_data().c_str()
+                                   );
+                
+                ++hist_i;
+            }
+            
+            legend_h->SetBit( TObject::kCanDelete );
+            legend_h->Draw("same");
             
-            auto const& range_x = legend_element.template retrieve_field< range<x> >().retrieve();
-            auto const& range_y = legend_element.template retrieve_field< range<y> >().retrieve();
+        }
+        
+        
+        template< class Element >
+        TLegend* make_legend( Element const& legend_element_p ) const {
+            auto const& range_x = legend_element_p.template retrieve_field< range<x> >().retrieve();
+            auto const& range_y = legend_element_p.template retrieve_field< range<y> >().retrieve();
             
             auto * legend_h = new TLegend{
                 range_x.low,
@@ -572,31 +935,527 @@ namespace iwir {
                 range_y.high
             };
             
-            auto const& header_field = legend_element.template retrieve_field< header<single> >().retrieve();
+            auto const& header_field = legend_element_p.template retrieve_field< header<single> >().retrieve();
             legend_h->SetHeader( header_field.user_data().c_str() );
             legend_h->SetTextColor( header_field.color );
             legend_h->SetTextSize( header_field.size );
+            return legend_h;
+        }
+        
+        
+        ///-------------------graph-----------------------
+        //graph configurations have no frame histogram: the first graph draws the axes, onto which the frame is applied
+    private:
+        template< class Image >
+        TCanvas* apply_graphs( Image const& image_p, std::vector<TGraph*>&& graph_pc ) const {
+            root_guard guard{ root_mutex() };
+            auto * canvas_h = new TCanvas{};
+            apply_graphs_impl( image_p, graph_pc, typename Image::configuration_type::elements{} );
+            return canvas_h;
+        }
+        
+        //graph_pc ends up holding what was actually drawn, downsampled copies included
+        template< class Image, class ... Ts>
+        void apply_graphs_impl( Image const& image_p,
+                                std::vector<TGraph*>& graph_pc,
+                                std::tuple<Ts...> ) const {
+            int expander[] = { 0, (apply_graph_element( image_p, graph_pc, Ts{}), void(), 0) ... };
+        }
+        
+        //pad and pave_text owe nothing to the graphs
+        template< class Image, class Element >
+        void apply_graph_element( Image const& image_p,
+                                  std::vector<TGraph*>& /*graph_pc*/,
+                                  Element ) const {
+            apply_element( image_p, std::vector<TH1D*>{}, Element{} );
+        }
+        
+        template< class Image >
+        void apply_graph_element( Image const& /*image_p*/,
+                                  std::vector<TGraph*>& /*graph_pc*/,
+                                  frame1d ) const {}
+        
+        template< class Image >
+        void apply_graph_element( Image const& image_p,
+                                  std::vector<TGraph*>& graph_pc,
+                                  graph ) const {
+            auto const& frame_element = image_p.template retrieve_element<frame1d>();
+            auto const& range_x = frame_element.template retrieve_field< range<x> >().retrieve();
+            auto const column_count = pixel_columns();
             
-            
-            auto hist_i = hist_pc.begin();
-            for( auto const& hist_element : image_p.template retrieve_element<histogram1d>() ) {
-                auto const& name_field = hist_element.template retrieve_field< name >().retrieve();
+            auto graph_i = graph_pc.begin();
+            for( auto const& graph_element : image_p.template retrieve_element<graph>() ) {
+                if( graph_i == graph_pc.end() ){ break; }
+                auto * graph_h = *graph_i;
                 
-                auto const& attributes_field = hist_element.template retrieve_field< legend_attributes >().retrieve();
+                auto const& marker_field = graph_element.template retrieve_field< marker >().retrieve();
+                graph_h->SetMarkerStyle( marker_field.style );
+                graph_h->SetMarkerSize( marker_field.size );
+                graph_h->SetMarkerColor( marker_field.color );
+                
+                auto const& line_field = graph_element.template retrieve_field< line >().retrieve();
+                graph_h->SetLineStyle( line_field.style );
+                graph_h->SetLineWidth( line_field.width );
+                graph_h->SetLineColor( line_field.color );
+                
+                //the graph given is left untouched, its reduced copy belongs to the canvas
+                //its columns span the range the frame shows, not the whole graph
+                auto const& sampling_field = graph_element.template retrieve_field< sampling >().retrieve();
+                if( auto * sampled_h = downsample( graph_h, sampling_field.plain_data(), column_count,
+                                                   range_x.low, range_x.high ) ){
+                    sampled_h->SetBit( TObject::kCanDelete );
+                    graph_h = sampled_h;
+                }
+                
+                //axes are drawn by the first graph only, empty options standing for line and markers as in ROOT
+                std::string option_text;
+                for( char c : graph_element.template retrieve_field< option >().retrieve().plain_data() ){
+                    if( c != 'a' && c != 'A' ){ option_text += c; }
+                }
+                if( option_text.empty() ){ option_text = "LP"; }
+                auto const is_first = graph_i == graph_pc.begin();
+                graph_h->Draw( ( is_first ? "A" + option_text : option_text ).c_str() );
+                if( is_first ){ restyle_graph_axes( frame_element, graph_h ); }
+                
+                *graph_i++ = graph_h;
+            }
+            graph_pc.erase( graph_i, graph_pc.end() );
+        }
+        
+        template< class Image >
+        void apply_graph_element( Image const& image_p,
+                                  std::vector<TGraph*>& graph_pc,
+                                  legend ) const {
+            auto * legend_h = make_legend( image_p.template retrieve_element<legend>() );
+            
+            auto graph_i = graph_pc.begin();
+            for( auto const& graph_element : image_p.template retrieve_element<graph>() ) {
+                if( graph_i == graph_pc.end() ){ break; }
+                auto const& attributes_field = graph_element.template retrieve_field< legend_attributes >().retrieve();
                 legend_h->AddEntry(
-                                *hist_i,
+                                *graph_i,
                                 attributes_field.user_data().c_str() ,
                                 attributes_field.plain_data().c_str()
                                    );
-                
-                ++hist_i;
+                ++graph_i;
             }
             
+            legend_h->SetBit( TObject::kCanDelete );
             legend_h->Draw("same");
+        }
+        
+        //ranges are in user coordinates, left to ROOT when empty
+        template< class Element >
+        void restyle_graph_axes( Element const& frame_element_p, TGraph* graph_ph ) const {
+            restyle_axis_text<x>( frame_element_p, graph_ph->GetXaxis() );
+            restyle_axis_text<y>( frame_element_p, graph_ph->GetYaxis() );
             
+            auto const& range_x = frame_element_p.template retrieve_field< range<x> >().retrieve();
+            if( range_x.high > range_x.low ){ graph_ph->GetXaxis()->SetLimits( range_x.low, range_x.high ); }
+            auto const& range_y = frame_element_p.template retrieve_field< range<y> >().retrieve();
+            if( range_y.high > range_y.low ){
+                graph_ph->SetMinimum( range_y.low );
+                graph_ph->SetMaximum( range_y.high );
+            }
         }
         
-
+        //width of the plotting area of gPad, in pixels: graphs sampled to it look the same as when drawn whole
+        std::size_t pixel_columns() const {
+            auto const width = gPad->GetWw() * ( 1. - gPad->GetLeftMargin() - gPad->GetRightMargin() );
+            return width > 1 ? static_cast<std::size_t>( width ) : 1;
+        }
+        
+        
+        ///-------------------update-----------------------
+    private:
+        template<class ... Ts>
+        std::unique_ptr<applied_configuration> track( formatted_content content_p,
+                                                      std::vector<TH1D*>&& hist_pc,
+                                                      TCanvas* canvas_ph ) const {
+            monotonic_arena arena;
+            arena_scope scope{ arena };
+            auto config = fill( make_image< configuration<Ts...> >(), std::move(content_p) );
+            auto bound_c = bind( config, std::move(hist_pc), lookup_context::current() );
+            
+            std::unique_ptr< applied_image< configuration<Ts...> > > result_h{
+                        new applied_image< configuration<Ts...> >{ shared_image< configuration<Ts...> >{ config } } };
+            result_h->canvas_h = apply( config, std::move(bound_c), canvas_ph );
+            result_h->opcode = content_p.opcode;
+            return result_h;
+        }
+        
+        //objects of the canvas, as drawn by apply
+        struct drawn_objects {
+            TH1* frame_h{nullptr};
+            std::vector<TH1D*> hist_c;
+            TLegend* legend_h{nullptr};
+            std::vector<TPaveText*> pave_text_c;
+        };
+        
+        drawn_objects collect( TCanvas const* canvas_ph ) const {
+            drawn_objects result;
+            for( auto * primitive_h : *canvas_ph->GetListOfPrimitives() ){
+                if( auto * legend_h = dynamic_cast<TLegend*>( primitive_h ) ){ result.legend_h = legend_h; continue; }
+                if( auto * pave_text_h = dynamic_cast<TPaveText*>( primitive_h ) ){
+                    //the title box ROOT adds by itself
+                    if( std::string{ pave_text_h->GetName() } != "title" ){ result.pave_text_c.push_back( pave_text_h ); }
+                    continue;
+                }
+                auto * hist_h = dynamic_cast<TH1*>( primitive_h );
+                if( !hist_h ){ continue; }
+                if( !result.frame_h && std::string{ hist_h->GetName() } == "frame" ){ result.frame_h = hist_h; continue; }
+                if( auto * hist1d_h = dynamic_cast<TH1D*>( hist_h ) ){ result.hist_c.push_back( hist1d_h ); }
+            }
+            return result;
+        }
+        
+        template<class ... Ts>
+        bool update_as( applied_configuration& applied_p, formatted_content content_p ) const {
+            monotonic_arena arena;
+            arena_scope scope{ arena };
+            auto config = fill( make_image< configuration<Ts...> >(), std::move(content_p) );
+            return update_from<Ts...>( applied_p, config );
+        }
+        
+        template<class ... Ts>
+        std::unique_ptr<applied_configuration> parse_as( formatted_content content_p ) const {
+            monotonic_arena arena;
+            arena_scope scope{ arena };
+            auto config = fill( make_image< configuration<Ts...> >(), std::move(content_p) );
+            
+            std::unique_ptr< applied_image< configuration<Ts...> > > result_h{
+                        new applied_image< configuration<Ts...> >{ shared_image< configuration<Ts...> >{ config } } };
+            result_h->opcode = content_p.opcode;
+            return result_h;
+        }
+        
+        template<class ... Ts>
+        bool update_from( applied_configuration& applied_p, applied_configuration const& parsed_p ) const {
+            return update_from<Ts...>( applied_p, static_cast< applied_image< configuration<Ts...> > const& >( parsed_p ).image );
+        }
+        
+        //config_p is a plain image, copied into the shared one kept only once it is known to fit, or a shared one
+        template<class ... Ts, class Image>
+        bool update_from( applied_configuration& applied_p, Image const& config_p ) const {
+            auto& applied = static_cast< applied_image< configuration<Ts...> >& >( applied_p );
+            
+            using elements = typename configuration<Ts...>::elements;
+            if( !same_structure( applied.image, config_p, elements{} ) ){ return false; }
+            
+            root_guard guard{ root_mutex() };
+            auto drawn = collect( applied.canvas_h );
+            
+            bool modified{false};
+            int expander[] = { 0, (modified |= update_element( applied.image, config_p, applied.canvas_h, drawn, Ts{} ), void(), 0) ... };
+            modified |= update_element( applied.image, config_p, applied.canvas_h, drawn, pad{} );
+            if( modified ){
+                applied.canvas_h->Modified();
+                applied.canvas_h->Update();
+            }
+            
+            applied.image = share_image( config_p );
+            return true;
+        }
+        
+        template<class Configuration>
+        shared_image<Configuration> share_image( image<Configuration> const& image_p ) const { return shared_image<Configuration>{ image_p }; }
+        template<class Configuration>
+        shared_image<Configuration> share_image( shared_image<Configuration> const& image_p ) const { return image_p; }
+        
+        template<class Old, class New, class ... Ts>
+        bool same_structure( Old const& old_p, New const& new_p, std::tuple<Ts...> ) const {
+            bool result{true};
+            int expander[] = { 0, (result = result && same_structure( old_p, new_p, Ts{} ), void(), 0) ... };
+            return result;
+        }
+        
+        template<class Old, class New, class Element>
+        bool same_structure( Old const& /*old_p*/, New const& /*new_p*/, Element ) const { return true; }
+        
+        template<class Old, class New>
+        bool same_structure( Old const& old_p, New const& new_p, histogram1d ) const {
+            auto const& old_element = old_p.template retrieve_element<histogram1d>();
+            auto const& new_element = new_p.template retrieve_element<histogram1d>();
+            if( old_element.size() != new_element.size() ){ return false; }
+            
+            auto const& old_option_c = old_element.template retrieve_column<option>();
+            auto const& new_option_c = new_element.template retrieve_column<option>();
+            auto const& selector_c = new_element.template retrieve_column<selector>();
+            for( std::size_t i{0} ; i < new_element.size() ; ++i ){
+                if( !selector_c[i].retrieve().value().empty() ){ return false; }
+                if( !same_entries( old_option_c[i].retrieve(), new_option_c[i].retrieve() ) ){ return false; }
+            }
+            return true;
+        }
+        
+        template<class Old, class New>
+        bool same_structure( Old const& old_p, New const& new_p, pave_text ) const {
+            auto const& old_element = old_p.template retrieve_element<pave_text>();
+            auto const& new_element = new_p.template retrieve_element<pave_text>();
+            if( std::distance( old_element.begin(), old_element.end() ) !=
+                std::distance( new_element.begin(), new_element.end() ) ){ return false; }
+            
+            auto old_i = old_element.begin();
+            for( auto const& text_element : new_element ){
+                auto const& old_header = (old_i++)->template retrieve_field< header<multiple> >();
+                auto const& new_header = text_element.template retrieve_field< header<multiple> >();
+                if( std::distance( old_header.begin(), old_header.end() ) !=
+                    std::distance( new_header.begin(), new_header.end() ) ){ return false; }
+            }
+            return true;
+        }
+        
+        
+        //each overload returns whether anything was changed
+        template<class Old, class New>
+        bool update_element( Old const& old_p, New const& new_p, TCanvas* canvas_ph, drawn_objects const& /*drawn_p*/, pad ) const {
+            auto const& old_element = old_p.template retrieve_element<pad>();
+            auto const& new_element = new_p.template retrieve_element<pad>();
+            
+            auto const& margin_x = new_element.template retrieve_field< range<x> >().retrieve();
+            auto const& margin_y = new_element.template retrieve_field< range<y> >().retrieve();
+            if( same_entries( old_element.template retrieve_field< range<x> >().retrieve(), margin_x ) &&
+                same_entries( old_element.template retrieve_field< range<y> >().retrieve(), margin_y ) ){ return false; }
+            
+            canvas_ph->SetTopMargin(margin_y.high);
+            canvas_ph->SetRightMargin(margin_x.high);
+            canvas_ph->SetBottomMargin(margin_y.low);
+            canvas_ph->SetLeftMargin(margin_x.low);
+            return true;
+        }
+        
+        template<class Axis, class Element>
+        bool update_axis( Element const& old_p, Element const& new_p, TAxis* axis_ph ) const {
+            bool modified{false};
+            
+            auto const& title_field = new_p.template retrieve_field< title<Axis> >().retrieve();
+            if( !same_entries( old_p.template retrieve_field< title<Axis> >().retrieve(), title_field ) ){
+                axis_ph->SetTitle( title_field.user_data().c_str() );
+                axis_ph->SetTitleSize( title_field.size );
+                axis_ph->SetTitleOffset( title_field.offset );
+                modified = true;
+            }
+            
+            auto const& range_field = new_p.template retrieve_field< range<Axis> >().retrieve();
+            if( !same_entries( old_p.template retrieve_field< range<Axis> >().retrieve(), range_field ) ){
+                axis_ph->SetRangeUser( range_field.low, range_field.high );
+                modified = true;
+            }
+            
+            auto const& label_field = new_p.template retrieve_field< label<Axis> >().retrieve();
+            if( !same_entries( old_p.template retrieve_field< label<Axis> >().retrieve(), label_field ) ){
+                axis_ph->SetLabelSize( label_field.size );
+                axis_ph->SetLabelOffset( label_field.offset );
+                modified = true;
+            }
+            
+            return modified;
+        }
+        
+        template<class Old, class New>
+        bool update_element( Old const& old_p, New const& new_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, frame1d ) const {
+            if( !drawn_p.frame_h ){ return false; }
+            auto const& old_element = old_p.template retrieve_element<frame1d>();
+            auto const& new_element = new_p.template retrieve_element<frame1d>();
+            
+            auto modified = update_axis<x>( old_element, new_element, drawn_p.frame_h->GetXaxis() );
+            return update_axis<y>( old_element, new_element, drawn_p.frame_h->GetYaxis() ) || modified;
+        }
+        
+        template<class Old, class New>
+        bool update_element( Old const& old_p, New const& new_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, histogram1d ) const {
+            auto const& old_element = old_p.template retrieve_element<histogram1d>();
+            auto const& new_element = new_p.template retrieve_element<histogram1d>();
+            bool modified{false};
+            
+            //column by column, as they are stored
+            auto const count = std::min( new_element.size(), drawn_p.hist_c.size() );
+            auto const& old_name_c = old_element.template retrieve_column<name>();
+            auto const& new_name_c = new_element.template retrieve_column<name>();
+            for( std::size_t i{0} ; i < count ; ++i ){
+                if( same_entries( old_name_c[i].retrieve(), new_name_c[i].retrieve() ) ){ continue; }
+                drawn_p.hist_c[i]->SetTitle( new_name_c[i].retrieve().plain_data().c_str() );
+                modified = true;
+            }
+            
+            auto const& old_marker_c = old_element.template retrieve_column<marker>();
+            auto const& new_marker_c = new_element.template retrieve_column<marker>();
+            for( std::size_t i{0} ; i < count ; ++i ){
+                auto const& marker_field = new_marker_c[i].retrieve();
+                if( same_entries( old_marker_c[i].retrieve(), marker_field ) ){ continue; }
+                drawn_p.hist_c[i]->SetMarkerStyle( marker_field.style );
+                drawn_p.hist_c[i]->SetMarkerSize( marker_field.size );
+                drawn_p.hist_c[i]->SetMarkerColor( marker_field.color );
+                modified = true;
+            }
+            
+            auto const& old_line_c = old_element.template retrieve_column<line>();
+            auto const& new_line_c = new_element.template retrieve_column<line>();
+            for( std::size_t i{0} ; i < count ; ++i ){
+                auto const& line_field = new_line_c[i].retrieve();
+                if( same_entries( old_line_c[i].retrieve(), line_field ) ){ continue; }
+                drawn_p.hist_c[i]->SetLineStyle( line_field.style );
+                drawn_p.hist_c[i]->SetLineWidth( line_field.width );
+                drawn_p.hist_c[i]->SetLineColor( line_field.color );
+                modified = true;
+            }
+            
+            if( !drawn_p.legend_h ){ return modified; }
+            
+            //legend entries follow the histograms, after the header entry SetHeader always adds first
+            auto const& old_attributes_c = old_element.template retrieve_column<legend_attributes>();
+            auto const& new_attributes_c = new_element.template retrieve_column<legend_attributes>();
+            auto & entry_c = *drawn_p.legend_h->GetListOfPrimitives();
+            for( std::size_t i{0} ; i < count ; ++i ){
+                auto const& attributes_field = new_attributes_c[i].retrieve();
+                if( same_entries( old_attributes_c[i].retrieve(), attributes_field ) ){ continue; }
+                auto * entry_h = dynamic_cast<TLegendEntry*>( entry_c.At( static_cast<int>(i) + 1 ) );
+                if( !entry_h ){ continue; }
+                entry_h->SetLabel( attributes_field.user_data().c_str() );
+                entry_h->SetOption( attributes_field.plain_data().c_str() );
+                modified = true;
+            }
+            return modified;
+        }
+        
+        template<class Old, class New>
+        bool update_element( Old const& old_p, New const& new_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, legend ) const {
+            if( !drawn_p.legend_h ){ return false; }
+            auto const& old_element = old_p.template retrieve_element<legend>();
+            auto const& new_element = new_p.template retrieve_element<legend>();
+            bool modified{false};
+            
+            auto const& header_field = new_element.template retrieve_field< header<single> >().retrieve();
+            if( !same_entries( old_element.template retrieve_field< header<single> >().retrieve(), header_field ) ){
+                drawn_p.legend_h->SetHeader( header_field.user_data().c_str() );
+                drawn_p.legend_h->SetTextColor( header_field.color );
+                drawn_p.legend_h->SetTextSize( header_field.size );
+                modified = true;
+            }
+            
+            return update_position( old_element, new_element, drawn_p.legend_h ) || modified;
+        }
+        
+        //legends are placed in NDC, pave texts in pad coordinates, as apply creates them
+        template<class Element>
+        bool update_position( Element const& old_p, Element const& new_p, TLegend* legend_ph ) const {
+            auto const& range_x = new_p.template retrieve_field< range<x> >().retrieve();
+            auto const& range_y = new_p.template retrieve_field< range<y> >().retrieve();
+            if( same_entries( old_p.template retrieve_field< range<x> >().retrieve(), range_x ) &&
+                same_entries( old_p.template retrieve_field< range<y> >().retrieve(), range_y ) ){ return false; }
+            
+            legend_ph->SetX1NDC( range_x.low );
+            legend_ph->SetY1NDC( range_y.low );
+            legend_ph->SetX2NDC( range_x.high );
+            legend_ph->SetY2NDC( range_y.high );
+            return true;
+        }
+        
+        template<class Element>
+        bool update_position( Element const& old_p, Element const& new_p, TPaveText* pave_text_ph ) const {
+            auto const& range_x = new_p.template retrieve_field< range<x> >().retrieve();
+            auto const& range_y = new_p.template retrieve_field< range<y> >().retrieve();
+            if( same_entries( old_p.template retrieve_field< range<x> >().retrieve(), range_x ) &&
+                same_entries( old_p.template retrieve_field< range<y> >().retrieve(), range_y ) ){ return false; }
+            
+            pave_text_ph->SetX1( range_x.low );
+            pave_text_ph->SetY1( range_y.low );
+            pave_text_ph->SetX2( range_x.high );
+            pave_text_ph->SetY2( range_y.high );
+            return true;
+        }
+        
+        template<class Old, class New>
+        bool update_element( Old const& old_p, New const& new_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, pave_text ) const {
+            auto const& old_element = old_p.template retrieve_element<pave_text>();
+            bool modified{false};
+            
+            auto old_i = old_element.begin();
+            auto pave_text_i = drawn_p.pave_text_c.begin();
+            for( auto const& text_element : new_p.template retrieve_element<pave_text>() ){
+                if( pave_text_i == drawn_p.pave_text_c.end() ){ break; }
+                auto * pave_text_h = *pave_text_i++;
+                auto const& old_text_element = *old_i++;
+                
+                modified = update_position( old_text_element, text_element, pave_text_h ) || modified;
+                
+                auto const& old_header = old_text_element.template retrieve_field< header<multiple> >();
+                auto old_header_i = old_header.begin();
+                int index{0};
+                for( auto const& header_field : text_element.template retrieve_field< header<multiple> >() ){
+                    auto const& header = header_field.retrieve();
+                    auto const& old_header_field = *old_header_i++;
+                    auto * text_h = dynamic_cast<TText*>( pave_text_h->GetListOfLines()->At( index++ ) );
+                    if( !text_h || same_entries( old_header_field.retrieve(), header ) ){ continue; }
+                    
+                    text_h->SetTitle( header.user_data().c_str() );
+                    text_h->SetTextSize( header.size );
+                    text_h->SetTextColor( header.color );
+                    modified = true;
+                }
+            }
+            return modified;
+        }
+        
+        
+        ///-------------------partial-----------------------
+        template<class Image>
+        void apply_onto( Image const& image_p, TCanvas* canvas_ph, drawn_objects const& /*drawn_p*/, pad ) const {
+            auto const& pad_element = image_p.template retrieve_element<pad>();
+            auto const& margin_x = pad_element.template retrieve_field< range<x> >().retrieve();
+            auto const& margin_y = pad_element.template retrieve_field< range<y> >().retrieve();
+            canvas_ph->SetTopMargin(margin_y.high);
+            canvas_ph->SetRightMargin(margin_x.high);
+            canvas_ph->SetBottomMargin(margin_y.low);
+            canvas_ph->SetLeftMargin(margin_x.low);
+        }
+        
+        template<class Image>
+        void apply_onto( Image const& image_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, frame1d ) const {
+            if( !drawn_p.frame_h ){ return; }
+            auto const& frame_element = image_p.template retrieve_element<frame1d>();
+            restyle_axis<x>( frame_element, drawn_p.frame_h->GetXaxis() );
+            restyle_axis<y>( frame_element, drawn_p.frame_h->GetYaxis() );
+        }
+        
+        template<class Image>
+        void apply_onto( Image const& image_p, TCanvas* /*canvas_ph*/, drawn_objects const& drawn_p, histogram1d ) const {
+            auto hist_i = drawn_p.hist_c.begin();
+            for( auto const& hist_element : image_p.template retrieve_element<histogram1d>() ) {
+                if( hist_i == drawn_p.hist_c.end() ){ break; }
+                auto * hist_h = *hist_i++;
+                
+                hist_h->SetTitle( hist_element.template retrieve_field< name >().retrieve().plain_data().c_str() );
+                
+                auto const& marker_field = hist_element.template retrieve_field< marker >().retrieve();
+                hist_h->SetMarkerStyle( marker_field.style );
+                hist_h->SetMarkerSize( marker_field.size );
+                hist_h->SetMarkerColor( marker_field.color );
+                
+                auto const& line_field = hist_element.template retrieve_field< line >().retrieve();
+                hist_h->SetLineStyle( line_field.style );
+                hist_h->SetLineWidth( line_field.width );
+                hist_h->SetLineColor( line_field.color );
+            }
+        }
+        
+        template<class Image>
+        void apply_onto( Image const& image_p, TCanvas* canvas_ph, drawn_objects const& drawn_p, legend ) const {
+            if( drawn_p.legend_h ){
+                canvas_ph->GetListOfPrimitives()->Remove( drawn_p.legend_h );
+                delete drawn_p.legend_h;
+            }
+            apply_element( image_p, std::vector<TH1D*>{ drawn_p.hist_c }, legend{} );
+        }
+        
+        template<class Image>
+        void apply_onto( Image const& image_p, TCanvas* canvas_ph, drawn_objects const& drawn_p, pave_text ) const {
+            for( auto * pave_text_h : drawn_p.pave_text_c ){
+                canvas_ph->GetListOfPrimitives()->Remove( pave_text_h );
+                delete pave_text_h;
+            }
+            apply_element( image_p, std::vector<TH1D*>{}, pave_text{} );
+        }
     };
     
 }//namespace iwir
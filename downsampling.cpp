@@ -0,0 +1,145 @@
+//
+//File      : downsampling.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "downsampling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace iwir {
+
+    std::vector<std::size_t> minmax_columns( double const* x_ph, double const* y_ph,
+                                             std::size_t count_p, std::size_t column_count_p,
+                                             double low_p, double high_p ) {
+        std::vector<std::size_t> result_c;
+        if( !count_p || !column_count_p ){ return result_c; }
+        result_c.reserve( 4 * column_count_p );
+
+        auto const first_x = high_p > low_p ? low_p : x_ph[0];
+        auto const span = high_p > low_p ? high_p - low_p : x_ph[count_p - 1] - first_x;
+        auto column_of = [&]( double x_p ){
+            if( !(span > 0) ){ return std::size_t{0}; }
+            auto const position = (x_p - first_x) / span * column_count_p;
+            if( !(position > 0) ){ return std::size_t{0}; }
+            return std::min( static_cast<std::size_t>( position ), column_count_p - 1 );
+        };
+
+        //the points of a column are contiguous, their x being sorted
+        std::size_t begin{0};
+        while( begin < count_p ){
+            auto const column = column_of( x_ph[begin] );
+            auto lowest = begin, highest = begin;
+            auto end = begin + 1;
+            for( ; end < count_p && column_of( x_ph[end] ) == column ; ++end ){
+                if( y_ph[end] < y_ph[lowest] ){ lowest = end; }
+                if( y_ph[end] > y_ph[highest] ){ highest = end; }
+            }
+
+            std::size_t kept_c[4] = { begin, std::min( lowest, highest ), std::max( lowest, highest ), end - 1 };
+            for( auto index : kept_c ){
+                if( result_c.empty() || result_c.back() != index ){ result_c.push_back( index ); }
+            }
+            begin = end;
+        }
+        return result_c;
+    }
+
+    std::vector<std::size_t> largest_triangle_three_buckets( double const* x_ph, double const* y_ph,
+                                                             std::size_t count_p, std::size_t kept_count_p ) {
+        std::vector<std::size_t> result_c;
+        if( kept_count_p >= count_p || kept_count_p < 3 ){
+            result_c.resize( count_p );
+            for( std::size_t i{0} ; i < count_p ; ++i ){ result_c[i] = i; }
+            return result_c;
+        }
+        result_c.reserve( kept_count_p );
+
+        //buckets split the points between the first and the last one
+        auto const bucket_size = double( count_p - 2 ) / ( kept_count_p - 2 );
+        auto bucket_begin = [&]( std::size_t bucket_p ){ return static_cast<std::size_t>( bucket_p * bucket_size ) + 1; };
+
+        std::size_t previous{0};
+        result_c.push_back( previous );
+        for( std::size_t bucket{0} ; bucket < kept_count_p - 2 ; ++bucket ){
+            auto const begin = bucket_begin( bucket );
+            auto const end = bucket_begin( bucket + 1 );
+
+            //mean of the next bucket, the last point standing for it at the end
+            auto const next_begin = end;
+            auto const next_end = std::min( bucket_begin( bucket + 2 ), count_p );
+            double mean_x{0}, mean_y{0};
+            for( auto i = next_begin ; i < next_end ; ++i ){ mean_x += x_ph[i]; mean_y += y_ph[i]; }
+            auto const next_count = static_cast<double>( std::max<std::size_t>( next_end - next_begin, 1 ) );
+            if( next_end > next_begin ){ mean_x /= next_count; mean_y /= next_count; }
+            else{ mean_x = x_ph[count_p - 1]; mean_y = y_ph[count_p - 1]; }
+
+            auto picked = begin;
+            double largest_area{-1};
+            for( auto i = begin ; i < end ; ++i ){
+                auto const area = std::abs( (x_ph[previous] - mean_x) * (y_ph[i] - y_ph[previous]) -
+                                            (x_ph[previous] - x_ph[i]) * (mean_y - y_ph[previous]) );
+                if( area > largest_area ){ largest_area = area; picked = i; }
+            }
+            result_c.push_back( picked );
+            previous = picked;
+        }
+        result_c.push_back( count_p - 1 );
+        return result_c;
+    }
+
+
+    TGraph* downsample( TGraph const* graph_ph, std::string const& method_p, std::size_t column_count_p,
+                        double low_p, double high_p ) {
+        if( method_p.empty() || !column_count_p ){ return nullptr; }
+        if( method_p != "minmax" && method_p != "lttb" ){
+            std::cerr << "Unknown sampling: " << method_p << "\n";
+            return nullptr;
+        }
+        //errors, or whatever else a derived class holds per point, would be dropped
+        if( graph_ph->IsA() != TGraph::Class() ){ return nullptr; }
+
+        auto const count = static_cast<std::size_t>( graph_ph->GetN() );
+        auto const * x_h = graph_ph->GetX();
+        auto const * y_h = graph_ph->GetY();
+        if( !std::is_sorted( x_h, x_h + count ) ){ return nullptr; }
+
+        //columns only cover what is shown, the points next to it being kept for the lines leaving the frame
+        std::size_t begin{0}, end{count};
+        if( high_p > low_p ){
+            begin = std::lower_bound( x_h, x_h + count, low_p ) - x_h;
+            end = std::upper_bound( x_h, x_h + count, high_p ) - x_h;
+        }
+        auto const shown_count = end - begin;
+
+        //up to four points per column for minmax, two per column keep lttb as sharp
+        auto const kept_count = std::max<std::size_t>( (method_p == "minmax" ? 4 : 2) * column_count_p, 3 );
+        if( shown_count <= kept_count ){ return nullptr; }
+
+        auto shown_c = method_p == "minmax" ?
+                    minmax_columns( x_h + begin, y_h + begin, shown_count, column_count_p, low_p, high_p ) :
+                    largest_triangle_three_buckets( x_h + begin, y_h + begin, shown_count, kept_count );
+
+        std::vector<std::size_t> index_c;
+        index_c.reserve( shown_c.size() + 2 );
+        if( begin > 0 ){ index_c.push_back( begin - 1 ); }
+        for( auto index : shown_c ){ index_c.push_back( begin + index ); }
+        if( end < count ){ index_c.push_back( end ); }
+
+        auto * result_h = new TGraph{ static_cast<int>( index_c.size() ) };
+        for( std::size_t i{0} ; i < index_c.size() ; ++i ){
+            result_h->SetPoint( static_cast<int>( i ), x_h[ index_c[i] ], y_h[ index_c[i] ] );
+        }
+        result_h->SetName( graph_ph->GetName() );
+        result_h->SetTitle( graph_ph->GetTitle() );
+        graph_ph->TAttLine::Copy( *result_h );
+        graph_ph->TAttMarker::Copy( *result_h );
+        graph_ph->TAttFill::Copy( *result_h );
+        return result_h;
+    }
+
+} //namespace iwir
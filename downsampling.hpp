@@ -0,0 +1,47 @@
+//
+//File      : downsampling.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef downsampling_h
+#define downsampling_h
+
+//std headers
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+//ROOT header
+#include "TGraph.h"
+
+
+namespace iwir {
+
+    //------------------------------downsampling----------------------------------------
+    //points are given sorted along x, the indices kept are returned in increasing order
+
+    //first, last, lowest and highest point of each of the column_count_p columns spanning [low_p, high_p], or the
+    //points themselves when that range is empty: a line through them covers the same pixels as the line through every point
+    std::vector<std::size_t> minmax_columns( double const* x_ph, double const* y_ph,
+                                             std::size_t count_p, std::size_t column_count_p,
+                                             double low_p = 0, double high_p = 0 );
+
+    //largest triangle three buckets: kept_count_p points, the first and the last ones included, each picked in its
+    //bucket as the one making the largest triangle with the previous pick and the mean of the next bucket
+    std::vector<std::size_t> largest_triangle_three_buckets( double const* x_ph, double const* y_ph,
+                                                             std::size_t count_p, std::size_t kept_count_p );
+
+    //copy of the graph reduced with method_p ("minmax" or "lttb") for a pad column_count_p pixels wide showing x in
+    //[low_p, high_p] (the whole graph when empty), with the same name, title and attributes; the points shown are
+    //reduced, those out of the range dropped but for the one on each side
+    //nullptr when it is to be drawn as it is: no or unknown method, not more points shown than the method would keep,
+    //points not sorted along x, or a class carrying more than the points (errors, ...)
+    TGraph* downsample( TGraph const* graph_ph, std::string const& method_p, std::size_t column_count_p,
+                        double low_p = 0, double high_p = 0 );
+
+} //namespace iwir
+
+#endif /* downsampling_h */
@@ -41,6 +41,22 @@ struct pave_text_flag{
 };
 template<> struct flag_traits<pave_text_flag>{ using is_authorized = std::true_type; };
 
+struct graph_flag{
+    static constexpr uint8_t shift = 5;
+};
+template<> struct flag_traits<graph_flag>{ using is_authorized = std::true_type; };
+
+//only used in element masks, see configurator::apply_elements: every configuration has a pad and a frame
+struct frame_flag{
+    static constexpr uint8_t shift = 3;
+};
+template<> struct flag_traits<frame_flag>{ using is_authorized = std::true_type; };
+
+struct pad_flag{
+    static constexpr uint8_t shift = 4;
+};
+template<> struct flag_traits<pad_flag>{ using is_authorized = std::true_type; };
+
 
 
 
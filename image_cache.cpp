@@ -0,0 +1,127 @@
+//
+//File      : image_cache.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "image_cache.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace iwir {
+
+    namespace {
+        //closes the descriptor on every path out
+        struct descriptor {
+            explicit descriptor( int value_p ) : value{ value_p } {}
+            ~descriptor(){ if( value >= 0 ){ ::close( value ); } }
+            descriptor( descriptor const& ) = delete;
+            descriptor& operator=( descriptor const& ) = delete;
+            int value;
+        };
+    }
+
+
+    mapped_blob::~mapped_blob() {
+        ::munmap( const_cast<void*>( data_mh ), size_m );
+    }
+
+
+    image_cache* image_cache::node() {
+        static image_cache* cache_h = []() -> image_cache* {
+            auto const* directory_h = std::getenv( "IWIR_IMAGE_CACHE" );
+            if( !directory_h || !*directory_h ){ return nullptr; }
+            
+            ::mkdir( directory_h, 0777 );
+            struct stat status;
+            if( ::stat( directory_h, &status ) != 0 || !S_ISDIR( status.st_mode ) ){
+                std::cerr << "Could not use image cache directory: " << directory_h << '\n';
+                return nullptr;
+            }
+            return new image_cache{ directory_h };
+        }();
+        return cache_h;
+    }
+
+    //FNV-1a
+    std::uint64_t image_cache::hash( std::string const& content_p ) {
+        std::uint64_t result{ 14695981039346656037ULL };
+        for( unsigned char c : content_p ){
+            result ^= c;
+            result *= 1099511628211ULL;
+        }
+        return result;
+    }
+
+
+    std::shared_ptr<mapped_blob const> image_cache::find_or_build( std::string const& key_p,
+                                                                   std::function< std::string() > const& build_p ) const {
+        auto const file = directory_m + '/' + key_p;
+        if( auto blob_h = map( file ) ){ return blob_h; }
+        
+        //the other jobs missing it at the same time wait here for the first one to publish it, instead of parsing as well
+        //flock is released by the system if the holder dies
+        auto const lock_file = file + ".lock";
+        descriptor lock{ ::open( lock_file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666 ) };
+        if( lock.value >= 0 ){ ::flock( lock.value, LOCK_EX ); }
+        
+        if( auto blob_h = map( file ) ){ return blob_h; }
+        auto const published = publish( file, build_p() );
+        //still held: whoever waits on it, or locks it before it is gone, finds the blob when it gets it
+        if( lock.value >= 0 ){ ::unlink( lock_file.c_str() ); }
+        if( !published ){ return nullptr; }
+        return map( file );
+    }
+
+    std::shared_ptr<mapped_blob const> image_cache::map( std::string const& file_p ) const {
+        descriptor file{ ::open( file_p.c_str(), O_RDONLY | O_CLOEXEC ) };
+        if( file.value < 0 ){ return nullptr; }
+        
+        struct stat status;
+        if( ::fstat( file.value, &status ) != 0 || status.st_size == 0 ){ return nullptr; }
+        
+        auto const size = static_cast<std::size_t>( status.st_size );
+        auto * data_h = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, file.value, 0 );
+        if( data_h == MAP_FAILED ){ return nullptr; }
+        return std::make_shared<mapped_blob const>( data_h, size );
+    }
+
+    //written aside and renamed, so that a blob is either complete or absent
+    bool image_cache::publish( std::string const& file_p, std::string const& blob_p ) const {
+        if( blob_p.empty() ){ return false; }
+        
+        auto const temporary_file = file_p + '.' + std::to_string( ::getpid() );
+        descriptor output{ ::open( temporary_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 ) };
+        if( output.value < 0 ){
+            std::cerr << "Could not write to image cache: " << temporary_file << '\n';
+            return false;
+        }
+        
+        std::size_t written{0};
+        while( written < blob_p.size() ){
+            auto const count = ::write( output.value, blob_p.data() + written, blob_p.size() - written );
+            if( count <= 0 ){
+                std::cerr << "Could not write to image cache: " << temporary_file << '\n';
+                std::remove( temporary_file.c_str() );
+                return false;
+            }
+            written += static_cast<std::size_t>( count );
+        }
+        
+        if( std::rename( temporary_file.c_str(), file_p.c_str() ) != 0 ){
+            std::remove( temporary_file.c_str() );
+            return false;
+        }
+        return true;
+    }
+
+} //namespace iwir
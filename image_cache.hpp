@@ -0,0 +1,64 @@
+//
+//File      : image_cache.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef image_cache_h
+#define image_cache_h
+
+//std headers
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace iwir {
+
+    //binary form of an image (see image_codec.hpp), mapped read-only: every process of the node reading the same blob
+    //shares the same pages
+    struct mapped_blob {
+        mapped_blob( void const* data_ph, std::size_t size_p ) : data_mh{ data_ph }, size_m{ size_p } {}
+        ~mapped_blob();
+        mapped_blob( mapped_blob const& ) = delete;
+        mapped_blob& operator=( mapped_blob const& ) = delete;
+
+        char const* data() const { return static_cast<char const*>( data_mh ); }
+        std::size_t size() const { return size_m; }
+
+    private:
+        void const* data_mh;
+        std::size_t size_m;
+    };
+
+    //node-wide cache of parsed configurations, enabled by pointing IWIR_IMAGE_CACHE to a directory shared by the jobs
+    //of the node (a tmpfs such as /dev/shm/iwir is best: the blobs then live in shared memory)
+    //blobs are keyed by the hash of the configuration file and by the image type it is read into, so that an edited
+    //file simply gets new ones; they are published by rename, and built under a per-key lock, once per node
+    //nothing is evicted: blobs can be removed at any time, mapped ones staying readable and missing ones being built
+    //again, the lock files are removed once their blob is published
+    struct image_cache {
+        //nullptr when the cache is disabled
+        static image_cache* node();
+
+        static std::uint64_t hash( std::string const& content_p );
+
+        //maps the blob of the key, building and publishing it first when no process did, nullptr when it cannot be mapped
+        std::shared_ptr<mapped_blob const> find_or_build( std::string const& key_p,
+                                                          std::function< std::string() > const& build_p ) const;
+
+    private:
+        explicit image_cache( std::string directory_p ) : directory_m{ std::move(directory_p) } {}
+
+        std::shared_ptr<mapped_blob const> map( std::string const& file_p ) const;
+        bool publish( std::string const& file_p, std::string const& blob_p ) const;
+
+    private:
+        std::string directory_m;
+    };
+
+} //namespace iwir
+
+#endif /* image_cache_h */
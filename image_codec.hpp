@@ -0,0 +1,269 @@
+//
+//File      : image_codec.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef image_codec_h
+#define image_codec_h
+
+//iwir header
+#include "configuration_image.hpp"
+
+
+//std headers
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace iwir {
+
+    //------------------------------binary form----------------------------------------
+    //images point into their arena, this is their relocatable form: entries in declaration order, native byte order,
+    //doubles on 8 bytes, ints and lengths on 4, texts as length and bytes, elements and fields holding several values
+    //preceded by their count
+    //only meant to be read back by the same build on the same node (see image_cache.hpp)
+
+    namespace codec {
+
+        //spelling of one entry by the way it is encoded: d(ouble), i(nt), s(tring)
+        template<class T> struct entry_kind;
+        template<> struct entry_kind<double> { static constexpr char value = 'd'; };
+        template<> struct entry_kind<int>    { static constexpr char value = 'i'; };
+        template<class Allocator>
+        struct entry_kind< std::basic_string<char, std::char_traits<char>, Allocator> > { static constexpr char value = 's'; };
+
+        template<class ... Entries>
+        std::string describe_entries( std::tuple<Entries...> ){
+            return std::string{ entry_kind< std::decay_t< decltype( std::declval<Entries const&>().value() ) > >::value ... };
+        }
+
+        //silent fields have no anchor, their entries alone spell them
+        template<class Field>
+        std::string field_anchor( std::false_type ){ return std::string{ Field::anchor }; }
+        template<class Field>
+        std::string field_anchor( std::true_type ){ return {}; }
+
+        //fields and elements holding several values are marked with a *, they carry a count
+        template<class Field>
+        std::string describe_field( single_value_field<Field> const* ){
+            return field_anchor<Field>( typename field_traits<Field>::is_silent{} ) + '(' + describe_entries( typename Field::entries{} ) + ')';
+        }
+        template<class Field>
+        std::string describe_field( multiple_value_field<Field> const* ){
+            return field_anchor<Field>( typename field_traits<Field>::is_silent{} ) + "*(" + describe_entries( typename Field::entries{} ) + ')';
+        }
+
+        template<class ... Fields>
+        std::string describe_fields( std::tuple<Fields...> ){
+            std::string result;
+            int expander[] = { 0, (result += describe_field( static_cast< typename field_traits<Fields>::value_type const* >( nullptr ) ), void(), 0) ... };
+            return result;
+        }
+
+        template<class Element>
+        std::string describe_element( single_value_element<Element> const* ){
+            return std::string{ Element::anchor } + '{' + describe_fields( typename Element::fields{} ) + '}';
+        }
+        template<class Element, template<class> class Container>
+        std::string describe_element( Container<Element> const* ){
+            return std::string{ Element::anchor } + "*{" + describe_fields( typename Element::fields{} ) + '}';
+        }
+
+        template<class ... Elements>
+        std::string describe_elements( std::tuple<Elements...> ){
+            std::string result;
+            int expander[] = { 0, (result += ';' + describe_element( static_cast< typename element_traits<Elements>::value_type const* >( nullptr ) ), void(), 0) ... };
+            return result;
+        }
+
+    } //namespace codec
+
+    //spelling of the configuration, which the binary form does not carry by itself: the layout of every element,
+    //down to the kind of each entry, so that blobs written before a field was added, removed or retyped are never read
+    template<class Configuration> struct image_signature;
+    template<class ... Ts>
+    struct image_signature< configuration<Ts...> > {
+        static std::string value(){
+            return "iwir-image-1" + codec::describe_elements( typename configuration<Ts...>::elements{} );
+        }
+    };
+
+
+    struct image_encoder {
+        void write( double value_p ){ append( &value_p, sizeof(value_p) ); }
+        void write( int value_p ){ auto value = static_cast<std::int32_t>( value_p ); append( &value, sizeof(value) ); }
+        void write_count( std::size_t count_p ){ auto count = static_cast<std::uint32_t>( count_p ); append( &count, sizeof(count) ); }
+
+        template<class Allocator>
+        void write( std::basic_string<char, std::char_traits<char>, Allocator> const& value_p ){
+            write_count( value_p.size() );
+            append( value_p.data(), value_p.size() );
+        }
+
+        std::string data;
+
+    private:
+        void append( void const* value_ph, std::size_t size_p ){ data.append( static_cast<char const*>( value_ph ), size_p ); }
+    };
+
+    //every read is bounds checked: a truncated or foreign blob makes the decoding fail, never overrun
+    struct image_decoder {
+        image_decoder( char const* data_ph, std::size_t size_p ) : current_mh{ data_ph }, end_mh{ data_ph + size_p } {}
+
+        void read( double& value_p ){ extract( &value_p, sizeof(value_p) ); }
+        void read( int& value_p ){ std::int32_t value{0}; extract( &value, sizeof(value) ); value_p = value; }
+        std::size_t read_count(){ std::uint32_t count{0}; extract( &count, sizeof(count) ); return count; }
+
+        template<class Allocator>
+        void read( std::basic_string<char, std::char_traits<char>, Allocator>& value_p ){
+            auto const length = read_count();
+            if( !available( length ) ){ return; }
+            value_p.assign( current_mh, length );
+            current_mh += length;
+        }
+
+        bool good() const { return good_m; }
+        bool finished() const { return good_m && current_mh == end_mh; }
+
+    private:
+        bool available( std::size_t size_p ){
+            good_m = good_m && static_cast<std::size_t>( end_mh - current_mh ) >= size_p;
+            return good_m;
+        }
+        void extract( void* value_ph, std::size_t size_p ){
+            if( !available( size_p ) ){ return; }
+            std::memcpy( value_ph, current_mh, size_p );
+            current_mh += size_p;
+        }
+
+    private:
+        char const* current_mh;
+        char const* end_mh;
+        bool good_m{true};
+    };
+
+
+    namespace codec {
+
+        //------encode------
+        template<class Field, class ... Entries>
+        void encode_entries( image_encoder& encoder_p, Field const& field_p, std::tuple<Entries...> ){
+            int expander[] = { 0, (encoder_p.write( static_cast<Entries const&>(field_p).value() ), void(), 0) ... };
+        }
+
+        template<class Field>
+        void encode_field( image_encoder& encoder_p, single_value_field<Field> const& field_p ){
+            encode_entries( encoder_p, field_p.retrieve(), typename Field::entries{} );
+        }
+
+        template<class Field>
+        void encode_field( image_encoder& encoder_p, multiple_value_field<Field> const& field_p ){
+            encoder_p.write_count( std::distance( field_p.begin(), field_p.end() ) );
+            for( auto const& value : field_p ){ encode_entries( encoder_p, value.retrieve(), typename Field::entries{} ); }
+        }
+
+        template<class Element, class ... Fields>
+        void encode_fields( image_encoder& encoder_p, Element const& element_p, std::tuple<Fields...> ){
+            int expander[] = { 0, (encode_field( encoder_p, element_p.template retrieve_field<Fields>() ), void(), 0) ... };
+        }
+
+        template<class Element>
+        void encode_element( image_encoder& encoder_p, single_value_element<Element> const& element_p ){
+            encode_fields( encoder_p, element_p, typename Element::fields{} );
+        }
+
+        template<class Element>
+        void encode_element( image_encoder& encoder_p, multiple_value_element<Element> const& element_p ){
+            encoder_p.write_count( std::distance( element_p.begin(), element_p.end() ) );
+            for( auto const& value : element_p ){ encode_fields( encoder_p, value, typename Element::fields{} ); }
+        }
+
+        template<class Element>
+        void encode_element( image_encoder& encoder_p, columnar_value_element<Element> const& element_p ){
+            encoder_p.write_count( element_p.size() );
+            for( auto const& value : element_p ){ encode_fields( encoder_p, value, typename Element::fields{} ); }
+        }
+
+        //------decode------
+        template<class Field, class ... Entries>
+        void decode_entries( image_decoder& decoder_p, Field& field_p, std::tuple<Entries...> ){
+            int expander[] = { 0, (decoder_p.read( static_cast<Entries&>(field_p).value() ), void(), 0) ... };
+        }
+
+        template<class Field>
+        void decode_field( image_decoder& decoder_p, single_value_field<Field>& field_p ){
+            decode_entries( decoder_p, field_p.retrieve(), typename Field::entries{} );
+        }
+
+        template<class Field>
+        void decode_field( image_decoder& decoder_p, multiple_value_field<Field>& field_p ){
+            auto const count = decoder_p.read_count();
+            for( std::size_t i{0} ; i < count && decoder_p.good() ; ++i ){
+                decode_entries( decoder_p, field_p.add_value().retrieve(), typename Field::entries{} );
+            }
+        }
+
+        //taken by value: columnar elements hand out proxies
+        template<class Element, class ... Fields>
+        void decode_fields( image_decoder& decoder_p, Element&& element_p, std::tuple<Fields...> ){
+            int expander[] = { 0, (decode_field( decoder_p, element_p.template retrieve_field<Fields>() ), void(), 0) ... };
+        }
+
+        template<class Element>
+        void decode_element( image_decoder& decoder_p, single_value_element<Element>& element_p ){
+            decode_fields( decoder_p, element_p, typename Element::fields{} );
+        }
+
+        template<class Element>
+        void decode_element( image_decoder& decoder_p, multiple_value_element<Element>& element_p ){
+            auto const count = decoder_p.read_count();
+            for( std::size_t i{0} ; i < count && decoder_p.good() ; ++i ){
+                decode_fields( decoder_p, element_p.add_value(), typename Element::fields{} );
+            }
+        }
+
+        template<class Element>
+        void decode_element( image_decoder& decoder_p, columnar_value_element<Element>& element_p ){
+            auto const count = decoder_p.read_count();
+            for( std::size_t i{0} ; i < count && decoder_p.good() ; ++i ){
+                decode_fields( decoder_p, element_p.add_value(), typename Element::fields{} );
+            }
+        }
+
+        template<class Image, class ... Elements>
+        void encode_elements( image_encoder& encoder_p, Image const& image_p, std::tuple<Elements...> ){
+            int expander[] = { 0, (encode_element( encoder_p, image_p.template retrieve_element<Elements>() ), void(), 0) ... };
+        }
+
+        template<class Image, class ... Elements>
+        void decode_elements( image_decoder& decoder_p, Image& image_p, std::tuple<Elements...> ){
+            int expander[] = { 0, (decode_element( decoder_p, image_p.template retrieve_element<Elements>() ), void(), 0) ... };
+        }
+
+    } //namespace codec
+
+
+    template<class Configuration>
+    std::string encode( image<Configuration> const& image_p ){
+        image_encoder encoder;
+        codec::encode_elements( encoder, image_p, typename Configuration::elements{} );
+        return std::move(encoder.data);
+    }
+
+    //decodes into an empty image, allocating from the current arena; false when the blob does not hold exactly one image
+    template<class Configuration>
+    bool decode( image<Configuration>& image_p, char const* data_ph, std::size_t size_p ){
+        image_decoder decoder{ data_ph, size_p };
+        codec::decode_elements( decoder, image_p, typename Configuration::elements{} );
+        return decoder.finished();
+    }
+
+} //namespace iwir
+
+#endif /* image_codec_h */
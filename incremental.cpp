@@ -0,0 +1,67 @@
+//
+//File      : incremental.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "incremental.hpp"
+#include "root_context.hpp"
+
+#include <atomic>
+
+#include "TROOT.h"
+
+namespace iwir {
+
+    TCanvas* incremental_applier::canvas( std::string const& hist_list_p ) const {
+        auto applied_i = applied_mc.find( hist_list_p );
+        if( applied_i == applied_mc.end() || !applied_i->second || !applied_i->second->canvas_h ){ return nullptr; }
+        
+        auto name_i = canvas_name_mc.find( hist_list_p );
+        if( name_i == canvas_name_mc.end() ){ return nullptr; }
+        
+        //closing the canvas deletes it, its address is only trusted while gROOT lists it under the name it was given
+        root_guard guard{ root_mutex() };
+        auto * canvas_h = applied_i->second->canvas_h;
+        return gROOT->GetListOfCanvases()->FindObject( name_i->second.c_str() ) == canvas_h ? canvas_h : nullptr;
+    }
+    
+    TCanvas* incremental_applier::operator()( std::string const& config_file_p, std::string const& hist_list_p ) {
+        auto * canvas_h = canvas( hist_list_p );
+        auto& applied_h = applied_mc[ hist_list_p ];
+        
+        if( canvas_h && configurator{}.update( *applied_h, config_file_p ) ){ return canvas_h; }
+        return redraw( config_file_p, hist_list_p, canvas_h );
+    }
+    
+    TCanvas* incremental_applier::operator()( std::string const& config_file_p,
+                                              std::string const& hist_list_p,
+                                              applied_configuration const* parsed_ph ) {
+        auto * canvas_h = canvas( hist_list_p );
+        auto& applied_h = applied_mc[ hist_list_p ];
+        
+        if( canvas_h && parsed_ph && configurator{}.update( *applied_h, *parsed_ph ) ){ return canvas_h; }
+        return redraw( config_file_p, hist_list_p, canvas_h );
+    }
+    
+    TCanvas* incremental_applier::redraw( std::string const& config_file_p, std::string const& hist_list_p, TCanvas* canvas_ph ) {
+        auto& applied_h = applied_mc[ hist_list_p ];
+        applied_h = configurator{}.apply_tracked( config_file_p, hist_list_p, canvas_ph );
+        if( !applied_h ){
+            forget( hist_list_p );
+            return nullptr;
+        }
+        
+        //a canvas drawn again keeps the name it was given
+        if( !canvas_ph && applied_h->canvas_h ){
+            static std::atomic<unsigned long> canvas_count{0};
+            auto const name = "iwir_incremental_" + std::to_string( ++canvas_count );
+            root_guard guard{ root_mutex() };
+            applied_h->canvas_h->SetName( name.c_str() );
+            canvas_name_mc[ hist_list_p ] = name;
+        }
+        return applied_h->canvas_h;
+    }
+
+} //namespace iwir
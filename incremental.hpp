@@ -0,0 +1,56 @@
+//
+//File      : incremental.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef incremental_h
+#define incremental_h
+
+//iwir header
+#include "configurator.hpp"
+
+
+//std headers
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+
+//ROOT header
+#include "TCanvas.h"
+
+
+namespace iwir {
+
+    //keeps one canvas per list of histograms: applying a configuration again to the same list only touches
+    //the attributes that changed since the last time, instead of drawing a new canvas
+    //the canvas is drawn again from scratch when the change is structural, or when it has been closed
+    struct incremental_applier {
+        TCanvas* operator()( std::string const& config_file_p, std::string const& hist_list_p );
+        
+        //same, updating from a configuration parsed once for every canvas drawn from that file (see configurator::parse)
+        //config_file_p is only read again when the canvas has to be drawn from scratch
+        TCanvas* operator()( std::string const& config_file_p,
+                             std::string const& hist_list_p,
+                             applied_configuration const* parsed_ph );
+        
+        //canvas drawn for the list, nullptr when there is none or when it has been closed since
+        TCanvas* canvas( std::string const& hist_list_p ) const;
+        
+        void forget( std::string const& hist_list_p ){ applied_mc.erase( hist_list_p ); canvas_name_mc.erase( hist_list_p ); }
+        
+    private:
+        //the canvas given, if any, is cleared and drawn again
+        TCanvas* redraw( std::string const& config_file_p, std::string const& hist_list_p, TCanvas* canvas_ph );
+        
+    private:
+        std::unordered_map< std::string, std::unique_ptr<applied_configuration> > applied_mc;
+        //name given to each canvas drawn, unique to the process: another canvas at the same address does not bear it
+        std::unordered_map< std::string, std::string > canvas_name_mc;
+    };
+
+} //namespace iwir
+
+#endif /* incremental_h */
@@ -0,0 +1,69 @@
+//
+//File      : inline_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//allocations made by the pave_text lines of a canvas, kept inline (as field_traits asks for) or in a plain vector
+//usage: iwir-inline-bench [canvas_count]
+
+
+#include "configuration_image.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+namespace {
+
+    std::size_t allocation_count{0};
+
+    //pave_texts hold one to four lines, short enough for the small string buffer: only the container allocates
+    template<std::size_t N>
+    void run( std::size_t canvas_count_p, char const* label_p ) {
+        using line_container = iwir::inline_container< iwir::field< iwir::header<iwir::multiple> >, N >;
+
+        auto const first_count = allocation_count;
+        auto const start = std::chrono::steady_clock::now();
+        line_container kept;
+        for( std::size_t canvas{0} ; canvas < canvas_count_p ; ++canvas ){
+            line_container line_c;
+            for( std::size_t line{0} ; line <= canvas % 4 ; ++line ){
+                line_c.push_back( iwir::field< iwir::header<iwir::multiple> >{} );
+                line_c.back().template fill<iwir::user_text, iwir::size, iwir::color>( "line", 0.04, 1 );
+            }
+            //as the filled image is handed back by value
+            kept = std::move( line_c );
+        }
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << label_p << ": " << double( allocation_count - first_count ) / canvas_count_p << " allocations per canvas, "
+                  << elapsed.count() / canvas_count_p * 1e9 << " ns per canvas\n";
+    }
+
+} //namespace
+
+
+void* operator new( std::size_t size_p ) {
+    ++allocation_count;
+    if( auto * memory_h = std::malloc( size_p ? size_p : 1 ) ){ return memory_h; }
+    throw std::bad_alloc{};
+}
+void operator delete( void* memory_ph ) noexcept { std::free( memory_ph ); }
+void operator delete( void* memory_ph, std::size_t ) noexcept { std::free( memory_ph ); }
+
+
+int main( int argc, char* argv[] ) {
+    std::size_t const canvas_count = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+    if( !canvas_count ){
+        std::cerr << "usage: iwir-inline-bench [canvas_count]\n";
+        return 1;
+    }
+
+    run<0>( canvas_count, "vector" );
+    run<4>( canvas_count, "inline_vector<4>" );
+    return 0;
+}
@@ -0,0 +1,146 @@
+//
+//File      : inline_vector.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef inline_vector_h
+#define inline_vector_h
+
+#include "arena.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace iwir {
+
+    //vector keeping its first N values inside the object itself, spilling to the allocator past that
+    template<class T, std::size_t N>
+    struct inline_vector {
+        inline_vector() = default;
+
+        inline_vector( inline_vector const& other_p ) {
+            reserve( other_p.size_m );
+            for( auto const& value : other_p ){ push_back( value ); }
+        }
+
+        inline_vector( inline_vector&& other_p ) noexcept( std::is_nothrow_move_constructible<T>::value )
+            : allocator_m{ other_p.allocator_m } {
+            if( other_p.heap_mh ){
+                heap_mh = other_p.heap_mh;
+                size_m = other_p.size_m;
+                capacity_m = other_p.capacity_m;
+                other_p.heap_mh = nullptr;
+                other_p.size_m = 0;
+                other_p.capacity_m = N;
+                return;
+            }
+            for( auto& value : other_p ){
+                new ( data() + size_m ) T( std::move(value) );
+                ++size_m;
+            }
+            other_p.clear();
+        }
+
+        inline_vector& operator=( inline_vector const& other_p ) {
+            if( this != &other_p ){
+                clear();
+                reserve( other_p.size_m );
+                for( auto const& value : other_p ){ push_back( value ); }
+            }
+            return *this;
+        }
+
+        inline_vector& operator=( inline_vector&& other_p ) noexcept( std::is_nothrow_move_constructible<T>::value ) {
+            if( this == &other_p ){ return *this; }
+            clear();
+            if( other_p.heap_mh ){
+                if( heap_mh ){ allocator_m.deallocate( heap_mh, capacity_m ); }
+                allocator_m = other_p.allocator_m;
+                heap_mh = other_p.heap_mh;
+                size_m = other_p.size_m;
+                capacity_m = other_p.capacity_m;
+                other_p.heap_mh = nullptr;
+                other_p.size_m = 0;
+                other_p.capacity_m = N;
+                return *this;
+            }
+            //inline values are moved one by one, into storage at least N long: no allocation
+            for( auto& value : other_p ){
+                new ( data() + size_m ) T( std::move(value) );
+                ++size_m;
+            }
+            other_p.clear();
+            return *this;
+        }
+
+        ~inline_vector() {
+            clear();
+            if( heap_mh ){ allocator_m.deallocate( heap_mh, capacity_m ); }
+        }
+
+        void push_back( T const& value_p ) { emplace_back( value_p ); }
+        void push_back( T&& value_p ) { emplace_back( std::move(value_p) ); }
+
+        template<class ... Args>
+        T& emplace_back( Args&& ... args_p ) {
+            if( size_m == capacity_m ){ reserve( 2 * capacity_m + 1 ); }
+            auto * value_h = new ( data() + size_m ) T( std::forward<Args>(args_p)... );
+            ++size_m;
+            return *value_h;
+        }
+
+        void reserve( std::size_t capacity_p ) {
+            if( capacity_p <= capacity_m ){ return; }
+            auto * storage_h = allocator_m.allocate( capacity_p );
+            for( std::size_t i{0} ; i < size_m ; ++i ){
+                new ( storage_h + i ) T( std::move( data()[i] ) );
+                data()[i].~T();
+            }
+            if( heap_mh ){ allocator_m.deallocate( heap_mh, capacity_m ); }
+            heap_mh = storage_h;
+            capacity_m = capacity_p;
+        }
+
+        void clear() {
+            for( std::size_t i{0} ; i < size_m ; ++i ){ data()[i].~T(); }
+            size_m = 0;
+        }
+
+        T & operator[](std::size_t index_p){ return data()[index_p]; }
+        T const& operator[](std::size_t index_p) const { return data()[index_p]; }
+
+        T & back() { return data()[size_m - 1]; }
+        T const& back() const { return data()[size_m - 1]; }
+
+        std::size_t size() const { return size_m; }
+        bool is_inline() const { return heap_mh == nullptr; }
+
+        T * begin() { return data(); }
+        T const* begin() const { return data(); }
+        T * end() { return data() + size_m; }
+        T const* end() const { return data() + size_m; }
+
+    private:
+        T * data() { return heap_mh ? heap_mh : reinterpret_cast<T*>( buffer_m ); }
+        T const* data() const { return heap_mh ? heap_mh : reinterpret_cast<T const*>( buffer_m ); }
+
+    private:
+        arena_allocator<T> allocator_m;
+        T* heap_mh{nullptr};
+        std::size_t size_m{0};
+        std::size_t capacity_m{N};
+        typename std::aligned_storage< sizeof(T), alignof(T) >::type buffer_m[N];
+    };
+
+
+    //plain arena_vector when no inline capacity is asked for
+    template<class T, std::size_t N>
+    using inline_container = std::conditional_t< N == 0, arena_vector<T>, inline_vector<T, N> >;
+
+} //namespace iwir
+
+#endif /* inline_vector_h */
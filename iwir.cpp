@@ -9,17 +9,99 @@
 #include "iwir.hpp"
 #include "saver.hpp"
 #include "configurator.hpp"
+#include "flag_set.hpp"
+#include "batch.hpp"
+#include "parallel_renderer.hpp"
+#include "restyle.hpp"
+#include "key_index.hpp"
+#include "stream_renderer.hpp"
+#include "incremental.hpp"
+#include "watcher.hpp"
 
 #include <iostream>
+#include <memory>
 
 void save_configuration(TCanvas const* canvas_p, std::string output_filename_p = "default.config") {
     iwir::saver{}( canvas_p, output_filename_p );
 }
 
+void flush_saves() {
+    iwir::saver::flush();
+}
+
 void apply_configuration(std::string config_p, std::string hist_list_p) {
     iwir::configurator{}( config_p, hist_list_p );
 }
 
+bool plan_configuration(std::string config_p, std::string hist_list_p) {
+    auto const plan = iwir::configurator{}.plan( config_p, hist_list_p, iwir::lookup_context::current() );
+    plan.print( std::cout );
+    return plan.ok();
+}
+
+iwir::async_apply apply_configuration_async(std::string config_p, std::string hist_list_p) {
+    return iwir::apply_async( config_p, hist_list_p );
+}
+
+TCanvas* apply_configuration_incremental(std::string config_p, std::string hist_list_p) {
+    static iwir::incremental_applier applier;
+    return applier( config_p, hist_list_p );
+}
+
+void apply_configuration_elements(std::string config_p, std::string element_list_p, TCanvas* canvas_p) {
+    uint8_t mask{0};
+    for( auto const& element : iwir::regex_split( element_list_p, std::regex{"[^;]+"} ) ){
+        if( element == "pad" ){ mask |= flag_set<pad_flag>{}; }
+        else if( element == "frame1d" ){ mask |= flag_set<frame_flag>{}; }
+        else if( element == "hist1d" ){ mask |= flag_set<hist1d_flag>{}; }
+        else if( element == "legend" ){ mask |= flag_set<legend_flag>{}; }
+        else if( element == "pave_text" ){ mask |= flag_set<pave_text_flag>{}; }
+        else{ std::cerr << "Unknown element: " << element << "\n"; }
+    }
+    iwir::configurator{}.apply_elements( config_p, mask, canvas_p );
+}
+
+TCanvas* watch_configuration(std::string config_p, std::string hist_list_p) {
+    return iwir::config_watcher::instance().watch( config_p, hist_list_p );
+}
+
+void unwatch_configuration(std::string hist_list_p) {
+    iwir::config_watcher::instance().unwatch( hist_list_p );
+}
+
+void apply_style(std::string config_p, std::vector<TH1*> const& hist_pc) {
+    iwir::configurator{}.apply_style( config_p, hist_pc );
+}
+
+std::size_t restyle_file(std::string config_p, std::string root_file_p, std::string pattern_p) {
+    return iwir::restyle_file( config_p, root_file_p, pattern_p );
+}
+
+void render_batch(std::string manifest_p) {
+    iwir::batch_renderer{}( iwir::read_manifest( manifest_p ) );
+}
+
+bool plan_batch(std::string manifest_p) {
+    return iwir::batch_renderer{}.plan( iwir::read_manifest( manifest_p ) ).failure_c.empty();
+}
+
+void render_parallel(std::string manifest_p, unsigned worker_count_p = 0) {
+    iwir::parallel_renderer{ worker_count_p }( iwir::read_manifest( manifest_p ) );
+}
+
+void render_stream(std::string config_p, std::string root_file_p, std::string pattern_p, std::string output_pattern_p, unsigned budget_mb_p = 256) {
+    iwir::stream_renderer{ std::size_t{budget_mb_p} << 20 }( config_p, root_file_p, pattern_p, output_pattern_p );
+}
+
+void build_key_index(std::string root_file_p, unsigned thread_count_p = 1) {
+    std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str() ) };
+    if( !file_h || file_h->IsZombie() ){
+        std::cerr << "Could not open file: " << root_file_p << "\n";
+        return;
+    }
+    iwir::key_index::build( file_h.get(), thread_count_p ).save( iwir::key_index::sidecar_of( root_file_p ) );
+}
+
 void hello() {
     std::cout << "hello !\n";
 }
@@ -10,20 +10,51 @@
 
 
 //iwir header
+#include "async_apply.hpp"
 
 
 //std headers
 #include <fstream>
+#include <vector>
 
 
 //ROOT header
 #include "TCanvas.h"
+#include "TH1.h"
 
 
 void save_configuration(TCanvas const* canvas_p, std::string output_filename_p );
 
+void flush_saves();
+
 void apply_configuration(std::string config_p, std::string hist_list_p);
 
+bool plan_configuration(std::string config_p, std::string hist_list_p);
+
+iwir::async_apply apply_configuration_async(std::string config_p, std::string hist_list_p);
+
+TCanvas* apply_configuration_incremental(std::string config_p, std::string hist_list_p);
+
+void apply_configuration_elements(std::string config_p, std::string element_list_p, TCanvas* canvas_p);
+
+TCanvas* watch_configuration(std::string config_p, std::string hist_list_p);
+
+void unwatch_configuration(std::string hist_list_p);
+
+void apply_style(std::string config_p, std::vector<TH1*> const& hist_pc);
+
+std::size_t restyle_file(std::string config_p, std::string root_file_p, std::string pattern_p);
+
+void render_batch(std::string manifest_p);
+
+bool plan_batch(std::string manifest_p);
+
+void render_parallel(std::string manifest_p, unsigned worker_count_p);
+
+void render_stream(std::string config_p, std::string root_file_p, std::string pattern_p, std::string output_pattern_p, unsigned budget_mb_p);
+
+void build_key_index(std::string root_file_p, unsigned thread_count_p);
+
 void hello();
 
 namespace iwir {
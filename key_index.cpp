@@ -0,0 +1,261 @@
+//
+//File      : key_index.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "key_index.hpp"
+#include "root_context.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "TDirectory.h"
+#include "TKey.h"
+#include "TROOT.h"
+
+namespace iwir {
+
+    namespace {
+        //2: modification time in nanoseconds followed by the size
+        constexpr char const * sidecar_header = "iwir-index 2";
+
+        bool is_directory( TKey const* key_ph ) {
+            std::string class_name{ key_ph->GetClassName() };
+            return class_name == "TDirectoryFile" || class_name == "TDirectory";
+        }
+
+        key_entry make_entry( TKey const* key_ph, std::string path_p ) {
+            return key_entry{ std::move(path_p),
+                              key_ph->GetClassName(),
+                              key_ph->GetCycle(),
+                              key_ph->GetSeekKey(),
+                              key_ph->GetObjlen(),
+                              key_ph->GetNbytes() };
+        }
+
+        //every cycle is listed, only the highest one is kept by key_index::add
+        void collect( TDirectory* directory_ph, std::string const& prefix_p, std::vector<key_entry>& entry_pc ) {
+            for( auto * object_h : *directory_ph->GetListOfKeys() ){
+                auto * key_h = static_cast<TKey*>( object_h );
+                auto path = prefix_p + key_h->GetName();
+
+                if( is_directory( key_h ) ){
+                    auto * subdirectory_h = directory_ph->GetDirectory( key_h->GetName() );
+                    if( subdirectory_h ){ collect( subdirectory_h, path + "/", entry_pc ); }
+                    continue;
+                }
+                entry_pc.push_back( make_entry( key_h, std::move(path) ) );
+            }
+        }
+
+        //each worker reads through its own handle, TFile cannot be shared between threads
+        void collect_in_parallel( std::string const& file_name_p,
+                                  std::vector<std::string> const& directory_pc,
+                                  unsigned thread_count_p,
+                                  std::vector< std::vector<key_entry> >& entry_pcc ) {
+            ROOT::EnableThreadSafety();
+
+            std::atomic<std::size_t> next{0};
+            auto work = [&](){
+                auto file_h = open_private( file_name_p );
+                if( !file_h ){ return; }
+                for( auto index = next++ ; index < directory_pc.size() ; index = next++ ){
+                    auto * directory_h = file_h->GetDirectory( directory_pc[index].c_str() );
+                    if( directory_h ){ collect( directory_h, directory_pc[index] + "/", entry_pcc[index] ); }
+                }
+            };
+
+            std::vector<std::thread> thread_c;
+            thread_c.reserve( thread_count_p );
+            for( unsigned i{0} ; i < thread_count_p ; ++i ){ thread_c.emplace_back( work ); }
+            for( auto& thread : thread_c ){ thread.join(); }
+        }
+    } //namespace
+
+
+    file_stamp stamp_of( std::string const& file_p ) {
+        struct stat status;
+        if( stat( file_p.c_str(), &status ) != 0 ){ return {}; }
+        return { static_cast<long long>( status.st_mtim.tv_sec ) * 1000000000LL + status.st_mtim.tv_nsec,
+                 static_cast<long long>( status.st_size ) };
+    }
+
+
+    key_index key_index::build( TFile* file_ph, unsigned thread_count_p ) {
+        key_index result;
+        result.uuid_m = file_ph->GetUUID().AsString();
+        result.stamp_m = stamp_of( file_ph->GetName() );
+
+        std::vector<std::string> directory_c;
+        for( auto * object_h : *file_ph->GetListOfKeys() ){
+            auto * key_h = static_cast<TKey*>( object_h );
+            if( is_directory( key_h ) ){ directory_c.push_back( key_h->GetName() ); }
+            else { result.add( make_entry( key_h, key_h->GetName() ) ); }
+        }
+        //a name can be listed once per cycle
+        std::sort( directory_c.begin(), directory_c.end() );
+        directory_c.erase( std::unique( directory_c.begin(), directory_c.end() ), directory_c.end() );
+
+        //one slot per subdirectory, merged in listing order so that the result does not depend on scheduling
+        std::vector< std::vector<key_entry> > entry_cc( directory_c.size() );
+        thread_count_p = std::min<unsigned>( thread_count_p, directory_c.size() );
+        if( thread_count_p > 1 ){
+            collect_in_parallel( file_ph->GetName(), directory_c, thread_count_p, entry_cc );
+        }
+        else {
+            for( std::size_t i{0} ; i < directory_c.size() ; ++i ){
+                auto * directory_h = file_ph->GetDirectory( directory_c[i].c_str() );
+                if( directory_h ){ collect( directory_h, directory_c[i] + "/", entry_cc[i] ); }
+            }
+        }
+
+        for( auto& entry_c : entry_cc ){
+            for( auto& entry : entry_c ){ result.add( std::move(entry) ); }
+        }
+        return result;
+    }
+
+
+    std::unique_ptr<key_index> key_index::load( TFile* file_ph ) {
+        std::ifstream input{ sidecar_of( file_ph->GetName() ) };
+        if( !input.is_open() ){ return nullptr; }
+
+        std::string line;
+        if( !std::getline( input, line ) || line != sidecar_header ){ return nullptr; }
+
+        std::unique_ptr<key_index> result_h{ new key_index{} };
+        if( !( input >> result_h->uuid_m >> result_h->stamp_m.modification_ns >> result_h->stamp_m.size ) ){ return nullptr; }
+        if( result_h->uuid_m != file_ph->GetUUID().AsString() ||
+            result_h->stamp_m != stamp_of( file_ph->GetName() ) ){ return nullptr; }
+        input.ignore( 1 );
+
+        //cycle, seek, object length, stored length, class and path, tab separated: paths may hold spaces
+        while( std::getline( input, line ) ){
+            std::istringstream stream{ line };
+            key_entry entry;
+            if( !( stream >> entry.cycle >> entry.seek >> entry.object_length >> entry.stored_length ) ){ return nullptr; }
+            stream.ignore( 1 );
+            if( !std::getline( stream, entry.class_name, '\t' ) || !std::getline( stream, entry.path ) ){ return nullptr; }
+            result_h->add( std::move(entry) );
+        }
+        return result_h;
+    }
+
+
+    //an index once published is never modified: a newer one replaces it in the cache, holders keeping the older one
+    std::shared_ptr<key_index const> key_index::of( TFile* file_ph ) {
+        static std::mutex mutex;
+        static bool const fork_held = ( hold_across_fork( mutex ), true );
+        (void)fork_held;
+        static std::unordered_map< std::string, std::shared_ptr<key_index const> > cache_c;
+
+        std::lock_guard<std::mutex> lock{ mutex };
+        auto& index_h = cache_c[ file_ph->GetName() ];
+        if( index_h &&
+            index_h->uuid_m == file_ph->GetUUID().AsString() &&
+            index_h->stamp_m == stamp_of( file_ph->GetName() ) ){ return index_h; }
+
+        std::shared_ptr<key_index const> loaded_h{ load( file_ph ) };
+        index_h = loaded_h ? std::move(loaded_h) : std::make_shared<key_index const>( build( file_ph ) );
+        return index_h;
+    }
+
+
+    bool key_index::save( std::string const& sidecar_file_p ) const {
+        std::ofstream output{ sidecar_file_p };
+        if( !output.is_open() ){
+            std::cerr << "Could not open file: " << sidecar_file_p << "\n";
+            return false;
+        }
+
+        output << sidecar_header << '\n' << uuid_m << ' ' << stamp_m.modification_ns << ' ' << stamp_m.size << '\n';
+        for( auto const& entry : entry_c ){
+            output << entry.cycle << ' ' << entry.seek << ' '
+                   << entry.object_length << ' ' << entry.stored_length << '\t'
+                   << entry.class_name << '\t' << entry.path << '\n';
+        }
+        return static_cast<bool>( output );
+    }
+
+
+    key_entry const* key_index::find_path( std::string const& path_p ) const {
+        auto entry_i = path_c.find( path_p );
+        return entry_i != path_c.end() ? &entry_c[ entry_i->second ] : nullptr;
+    }
+
+    std::vector<key_entry const*> key_index::find_name( std::string const& name_p ) const {
+        std::vector<key_entry const*> result_c;
+        auto range = name_c.equal_range( name_p );
+        for( auto entry_i = range.first ; entry_i != range.second ; ++entry_i ){
+            result_c.push_back( &entry_c[ entry_i->second ] );
+        }
+        //bucket order is unspecified, shallowest paths come first
+        std::sort( result_c.begin(), result_c.end(),
+                   []( key_entry const* lhs_ph, key_entry const* rhs_ph )
+                   { return lhs_ph->seek < rhs_ph->seek; } );
+        std::stable_sort( result_c.begin(), result_c.end(),
+                          []( key_entry const* lhs_ph, key_entry const* rhs_ph )
+                          { return std::count( lhs_ph->path.begin(), lhs_ph->path.end(), '/' ) <
+                                   std::count( rhs_ph->path.begin(), rhs_ph->path.end(), '/' ); } );
+        return result_c;
+    }
+
+    key_entry const* key_index::resolve( std::string const& name_or_path_p ) const {
+        if( name_or_path_p.find('/') != std::string::npos ){ return find_path( name_or_path_p ); }
+        auto entry_c = find_name( name_or_path_p );
+        return entry_c.empty() ? nullptr : entry_c.front();
+    }
+
+
+    //as TFile::Recover does: the length of the key header is read first, then the header itself
+    TObject* read_object( TFile* file_ph, key_entry const& entry_p ) {
+        char start[64];
+        int byte_count{0}, object_length{0}, key_length{0};
+        if( file_ph->GetRecordHeader( start, entry_p.seek, sizeof(start), byte_count, object_length, key_length ) <= 0 ||
+            key_length <= 0 ){
+            std::cerr << "Could not read key of: " << entry_p.path << '\n';
+            return nullptr;
+        }
+        
+        std::vector<char> header_c( key_length );
+        if( file_ph->ReadBuffer( header_c.data(), entry_p.seek, key_length ) ){
+            std::cerr << "Could not read key of: " << entry_p.path << '\n';
+            return nullptr;
+        }
+        TKey key{ file_ph };
+        auto * buffer_h = header_c.data();
+        key.ReadKeyBuffer( buffer_h );
+        
+        //an index older than the file would point at another record
+        if( entry_p.name() != key.GetName() || entry_p.class_name != key.GetClassName() ){
+            std::cerr << "Key index out of date for: " << entry_p.path << '\n';
+            return nullptr;
+        }
+        return key.ReadObj();
+    }
+
+
+    void key_index::add( key_entry entry_p ) {
+        auto path_i = path_c.find( entry_p.path );
+        if( path_i != path_c.end() ){
+            if( entry_c[ path_i->second ].cycle < entry_p.cycle ){ entry_c[ path_i->second ] = std::move(entry_p); }
+            return;
+        }
+
+        auto name = entry_p.name();
+        path_c.emplace( entry_p.path, entry_c.size() );
+        name_c.emplace( std::move(name), entry_c.size() );
+        entry_c.push_back( std::move(entry_p) );
+    }
+
+} //namespace iwir
@@ -0,0 +1,89 @@
+//
+//File      : key_index.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef key_index_h
+#define key_index_h
+
+//std headers
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//ROOT header
+#include "TFile.h"
+
+
+namespace iwir {
+
+    struct key_entry {
+        std::string path;           //"name" or "directory/subdirectory/name"
+        std::string class_name;
+        short cycle;
+        long long seek;
+        int object_length;          //uncompressed size of the object
+        int stored_length;          //size of the key on disk
+
+        std::string name() const { return path.substr( path.rfind('/') + 1 ); }
+    };
+
+    //state of a file on disk: an UPDATE keeps its UUID and may land within the second, hence nanoseconds and size
+    struct file_stamp {
+        long long modification_ns{0};
+        long long size{0};
+
+        bool operator==( file_stamp const& other_p ) const { return modification_ns == other_p.modification_ns && size == other_p.size; }
+        bool operator!=( file_stamp const& other_p ) const { return !( *this == other_p ); }
+    };
+    //zero when the file cannot be stat'ed
+    file_stamp stamp_of( std::string const& file_p );
+
+    //every key of a file, subdirectories included, resolved by path or by name through hash lookups
+    //it can be persisted next to the file, in <file>.iwir-index, and is then only rebuilt when the file changed
+    struct key_index {
+        static std::string sidecar_of( std::string const& root_file_p ) { return root_file_p + ".iwir-index"; }
+
+        //walks the directory tree, top level subdirectories being spread over thread_count_p threads
+        static key_index build( TFile* file_ph, unsigned thread_count_p = 1 );
+
+        //sidecar if it exists and still matches the file (uuid, modification time and size), nullptr otherwise
+        static std::unique_ptr<key_index> load( TFile* file_ph );
+
+        //index of an opened file: the sidecar when valid, otherwise built once and kept for the session
+        //to be held for as long as its entries are used, a changed file getting a new index
+        static std::shared_ptr<key_index const> of( TFile* file_ph );
+
+    public:
+        bool save( std::string const& sidecar_file_p ) const;
+
+        key_entry const* find_path( std::string const& path_p ) const;
+        //highest cycle of every key with this name, whatever its directory
+        std::vector<key_entry const*> find_name( std::string const& name_p ) const;
+        //path when it holds a '/', name otherwise: the first match, nullptr if none
+        key_entry const* resolve( std::string const& name_or_path_p ) const;
+
+        std::vector<key_entry> const& entries() const { return entry_c; }
+
+    private:
+        void add( key_entry entry_p );
+
+    private:
+        std::string uuid_m;
+        file_stamp stamp_m;
+        std::vector<key_entry> entry_c;
+        std::unordered_map<std::string, std::size_t> path_c;
+        std::unordered_multimap<std::string, std::size_t> name_c;
+    };
+
+    //reads the object straight from the key at entry_p.seek, without listing any directory on the way
+    //the object is attached to the file itself, not to its subdirectory; nullptr when the key does not match the entry
+    TObject* read_object( TFile* file_ph, key_entry const& entry_p );
+
+} //namespace iwir
+
+#endif /* key_index_h */
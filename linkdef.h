@@ -2,6 +2,21 @@
 //#pragma link C++ class helloer;
 #pragma link C++ function hello;
 #pragma link C++ function save_configuration;
+#pragma link C++ function flush_saves;
 #pragma link C++ function apply_configuration;
+#pragma link C++ function plan_configuration;
+#pragma link C++ class iwir::async_apply-;
+#pragma link C++ function apply_configuration_async;
+#pragma link C++ function apply_configuration_incremental;
+#pragma link C++ function apply_configuration_elements;
+#pragma link C++ function watch_configuration;
+#pragma link C++ function unwatch_configuration;
+#pragma link C++ function apply_style;
+#pragma link C++ function restyle_file;
+#pragma link C++ function render_batch;
+#pragma link C++ function plan_batch;
+#pragma link C++ function render_parallel;
+#pragma link C++ function render_stream;
+#pragma link C++ function build_key_index;
 //defined_in "iwir.hpp";
 #endif
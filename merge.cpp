@@ -0,0 +1,73 @@
+//
+//File      : merge.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//iwir-merge: configurations saved by many jobs merged into one bundle, as hadd does for ROOT files
+
+
+#include "bundle.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    int usage() {
+        std::cerr << "usage: iwir-merge [-j thread_count] [-c chunk_size] <output_bundle> <config_1> [config_2 ...]\n"
+                     "       a @list argument stands for the files listed in list, one per line\n";
+        return 1;
+    }
+
+    bool expand( std::string const& argument_p, std::vector<std::string>& input_pc ) {
+        if( argument_p.empty() || argument_p[0] != '@' ){
+            input_pc.push_back( argument_p );
+            return true;
+        }
+
+        std::ifstream list{ argument_p.substr( 1 ) };
+        if( !list.is_open() ){
+            std::cerr << "Could not open file: " << argument_p.substr( 1 ) << "\n";
+            return false;
+        }
+        for( std::string line ; std::getline( list, line ) ; ){
+            if( !line.empty() ){ input_pc.push_back( line ); }
+        }
+        return true;
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    unsigned thread_count = std::thread::hardware_concurrency();
+    std::size_t chunk_size{1024};
+
+    int argument{1};
+    for( ; argument + 1 < argc && argv[argument][0] == '-' ; argument += 2 ){
+        std::string option{ argv[argument] };
+        if( option == "-j" ){ thread_count = std::strtoul( argv[argument + 1], nullptr, 10 ); }
+        else if( option == "-c" ){ chunk_size = std::strtoul( argv[argument + 1], nullptr, 10 ); }
+        else{ return usage(); }
+    }
+    if( argc - argument < 2 ){ return usage(); }
+
+    std::string const bundle{ argv[argument++] };
+    std::vector<std::string> input_c;
+    for( ; argument < argc ; ++argument ){
+        if( !expand( argv[argument], input_c ) ){ return 1; }
+    }
+
+    auto report = iwir::merge_configurations( input_c, bundle, thread_count, chunk_size );
+    //merge_configurations told why
+    if( !report.written ){ return 1; }
+    std::cout << "merged " << report.input_count - report.failed_count << " of " << report.input_count
+              << " configurations into " << report.unique_count << " distinct ones in " << report.seconds << "s\n";
+    return report.failed_count == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+//
+//File      : parallel_renderer.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "parallel_renderer.hpp"
+#include "saver.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <tuple>
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "TROOT.h"
+
+namespace iwir {
+
+    namespace {
+        enum job_status : unsigned char { pending = 0, done = 1, failed = 2 };
+
+        //lives in memory shared by the parent and its workers: the queue is a single counter over the sorted jobs,
+        //followed by one status per job
+        struct shared_queue {
+            std::atomic<std::size_t> next{0};
+            unsigned char* status() { return reinterpret_cast<unsigned char*>( this + 1 ); }
+        };
+    } //namespace
+
+    parallel_renderer::parallel_renderer( unsigned worker_count_p ) :
+        worker_count_m{ worker_count_p ? worker_count_p : std::max( 1U, std::thread::hardware_concurrency() ) } {}
+
+    batch_renderer::report parallel_renderer::operator()( std::vector<job> job_pc ) const {
+        batch_renderer::report result;
+        if( job_pc.empty() ){ return result; }
+
+        //jobs on the same file follow each other, so that a worker pulling a chunk reuses its opened file
+        std::stable_sort( job_pc.begin(), job_pc.end(),
+                          []( job const& lhs_p, job const& rhs_p )
+                          { return std::tie( lhs_p.file, lhs_p.config ) < std::tie( rhs_p.file, rhs_p.config ); } );
+
+        //the implicit multi-threading pool takes locks iwir knows nothing of, which a child could inherit held
+        if( ROOT::IsImplicitMTEnabled() ){
+            std::cerr << "Implicit multi-threading is enabled, rendering sequentially\n";
+            return batch_renderer{}( job_pc );
+        }
+
+        auto const job_count = job_pc.size();
+        auto const chunk_size = std::max<std::size_t>( 1, job_count / (worker_count_m * 32) );
+        auto const region_size = sizeof(shared_queue) + job_count;
+
+        auto * region_h = mmap( nullptr, region_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+        if( region_h == MAP_FAILED ){
+            std::cerr << "Could not map the job queue, rendering sequentially\n";
+            return batch_renderer{}( job_pc );
+        }
+        auto * queue_h = new (region_h) shared_queue{};
+        std::fill_n( queue_h->status(), job_count, pending );
+
+        auto start = std::chrono::steady_clock::now();
+
+        //the threads of iwir itself are left idle, their mutexes being taken around fork() (root_context.hpp)
+        saver::flush();
+        std::cout.flush();
+        std::cerr.flush();
+        std::vector<pid_t> worker_c;
+        for( unsigned i{0} ; i < worker_count_m ; ++i ){
+            auto pid = fork();
+            if( pid == 0 ){
+                gROOT->SetBatch( true );
+                batch_renderer renderer;
+                std::size_t first;
+                while( (first = queue_h->next.fetch_add( chunk_size )) < job_count ){
+                    auto last = std::min( first + chunk_size, job_count );
+                    for( auto index = first ; index < last ; ++index ){
+                        queue_h->status()[index] = renderer.render( job_pc[index] ) ? done : failed;
+                    }
+                }
+                std::fflush( nullptr );
+                _exit( 0 );
+            }
+            if( pid < 0 ){
+                std::cerr << "Could not fork worker " << i << "\n";
+                continue;
+            }
+            worker_c.push_back( pid );
+        }
+
+        if( worker_c.empty() ){
+            munmap( region_h, region_size );
+            return batch_renderer{}( job_pc );
+        }
+
+        for( auto pid : worker_c ){
+            int status;
+            waitpid( pid, &status, 0 );
+            if( !WIFEXITED(status) || WEXITSTATUS(status) != 0 ){
+                std::cerr << "Worker " << pid << " did not exit cleanly\n";
+            }
+        }
+
+        result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+        //jobs left pending were claimed by a worker which died on them
+        for( std::size_t index{0} ; index < job_count ; ++index ){
+            if( queue_h->status()[index] == done ){ ++result.rendered; }
+            else{ result.failure_c.push_back( job_pc[index].output ); }
+        }
+
+        queue_h->~shared_queue();
+        munmap( region_h, region_size );
+
+        std::cout << "rendered: " << result.rendered << " plots in " << result.seconds << "s ("
+                  << (result.seconds > 0 ? result.rendered / result.seconds : 0.) << " plots/s) with " << worker_c.size() << " workers, "
+                  << result.failure_c.size() << " failures\n";
+        return result;
+    }
+
+} //namespace iwir
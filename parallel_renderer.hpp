@@ -0,0 +1,34 @@
+//
+//File      : parallel_renderer.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef parallel_renderer_h
+#define parallel_renderer_h
+
+//iwir header
+#include "batch.hpp"
+
+
+//std headers
+#include <vector>
+
+
+namespace iwir {
+
+    //ROOT graphics are not thread safe: jobs are fanned out to forked worker processes instead,
+    //each one owning its own batch_renderer, hence its own files and configuration caches
+    struct parallel_renderer {
+        explicit parallel_renderer( unsigned worker_count_p = 0 );
+
+        batch_renderer::report operator()( std::vector<job> job_pc ) const;
+
+    private:
+        unsigned worker_count_m;
+    };
+
+} //namespace iwir
+
+#endif /* parallel_renderer_h */
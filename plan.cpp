@@ -0,0 +1,48 @@
+//
+//File      : plan.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "plan.hpp"
+
+namespace iwir {
+
+    bool render_plan::ok() const {
+        return known_configuration && missing_c.empty() && ambiguous_c.empty() && mistyped_c.empty() &&
+               listed_count == entry_count;
+    }
+
+    long long render_plan::bin_count() const {
+        long long result{0};
+        for( auto const& binding : binding_c ){ result += binding.bin_count; }
+        return result;
+    }
+
+    long long render_plan::read_bytes() const {
+        long long result{0};
+        for( auto const& binding : binding_c ){ result += binding.read_bytes; }
+        return result;
+    }
+
+    void render_plan::print( std::ostream& output_p ) const {
+        output_p << "plan for " << config_file << ": " << (ok() ? "ok" : "failed") << "\n";
+        if( !known_configuration ){
+            output_p << "   unknown configuration\n";
+            return;
+        }
+
+        if( listed_count != entry_count ){
+            output_p << "   " << listed_count << " histograms listed for " << entry_count << " positional hist1d entries\n";
+        }
+        for( auto const& name : missing_c ){ output_p << "   missing: " << name << "\n"; }
+        for( auto const& name : ambiguous_c ){ output_p << "   ambiguous: " << name << "\n"; }
+        for( auto const& name : mistyped_c ){ output_p << "   not a TH1D: " << name << "\n"; }
+        for( auto const& pattern : unmatched_c ){ output_p << "   selector matching nothing: " << pattern << "\n"; }
+
+        output_p << "   cost: " << binding_c.size() << " objects, " << bin_count() << " bins at most, "
+                 << read_bytes() << " bytes to read\n";
+    }
+
+} //namespace iwir
@@ -0,0 +1,54 @@
+//
+//File      : plan.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef plan_h
+#define plan_h
+
+//std headers
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace iwir {
+
+    //what applying a configuration to a list of histograms would do, worked out from the configuration and the key
+    //indexes alone: no histogram is read (see configurator::plan)
+    struct render_plan {
+        struct binding {
+            std::string name;           //as listed, or the selector it matched
+            std::string location;       //"<directory>/<name>" in memory, "<file>:<path>" on disk
+            long long bin_count;        //exact in memory, upper bound on disk: uncompressed size over sizeof(double)
+            long long read_bytes;       //size of the key on disk, 0 in memory
+        };
+
+    public:
+        //known configuration, every listed name bound to exactly one histogram, one per positional hist1d entry
+        bool ok() const;
+
+        long long bin_count() const;
+        long long read_bytes() const;
+
+        void print( std::ostream& output_p ) const;
+
+    public:
+        std::string config_file;
+        bool known_configuration{false};
+        std::size_t entry_count{0};             //positional hist1d entries, those without a selector
+        std::size_t listed_count{0};            //names in the histogram list
+        std::vector<binding> binding_c;         //in the order apply takes them: listed names, then selector matches
+
+        std::vector<std::string> missing_c;     //listed names found nowhere
+        std::vector<std::string> ambiguous_c;   //"<name>: <location>, <location>, ..."
+        std::vector<std::string> mistyped_c;    //"<name>: <class>", found but not a TH1D
+        std::vector<std::string> unmatched_c;   //selectors matching no histogram
+    };
+
+} //namespace iwir
+
+#endif /* plan_h */
@@ -0,0 +1,102 @@
+//
+//File      : rdf_styler.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "rdf_styler.hpp"
+
+#include <algorithm>
+
+#include "RVersion.h"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RResultHandle.hxx"
+#endif
+
+namespace iwir {
+
+    void rdf_styler::style( std::vector<result> const& result_pc, std::string const& config_file_p ) {
+        auto styler_i = styler_mc.find( config_file_p );
+        if( styler_i == styler_mc.end() ){
+            styler_i = styler_mc.emplace( config_file_p, configurator{}.prepare_style( config_file_p ) ).first;
+        }
+        if( !styler_i->second ){ return; }
+
+        auto const& styler = styler_i->second;
+        hook_mc.push_back( hook{ result_pc, [styler]( std::vector<TH1D*>&& hist_pc ) -> TCanvas* {
+            styler( std::vector<TH1*>( hist_pc.begin(), hist_pc.end() ), 0 );
+            return nullptr;
+        } } );
+    }
+
+    void rdf_styler::render( std::vector<result> const& result_pc,
+                             std::string const& config_file_p,
+                             std::string const& output_p ) {
+        auto applier_i = applier_mc.find( config_file_p );
+        if( applier_i == applier_mc.end() ){
+            applier_i = applier_mc.emplace( config_file_p, configurator{}.prepare( config_file_p ) ).first;
+        }
+        if( !applier_i->second ){ return; }
+
+        auto const& applier = applier_i->second;
+        hook_mc.push_back( hook{ result_pc, [applier, output_p]( std::vector<TH1D*>&& hist_pc ) -> TCanvas* {
+            //the histograms stay owned by their dataframe results
+            auto * canvas_h = applier( std::move(hist_pc) );
+            if( output_p.empty() ){ return canvas_h; }
+            canvas_h->SaveAs( output_p.c_str() );
+            delete canvas_h;
+            return nullptr;
+        } } );
+    }
+
+
+    std::size_t rdf_styler::flush() {
+        auto is_filled = []( hook const& hook_p ){
+            return std::all_of( hook_p.result_c.begin(), hook_p.result_c.end(),
+                                []( result const& result_p ){ return result_p.IsReady(); } );
+        };
+
+        //hooks are applied in the order they were attached, the remaining ones keep theirs
+        std::size_t applied{0};
+        std::vector<hook> waiting_c;
+        for( auto& hook : hook_mc ){
+            if( !is_filled( hook ) ){ waiting_c.push_back( std::move(hook) ); continue; }
+
+            std::vector<TH1D*> hist_c;
+            hist_c.reserve( hook.result_c.size() );
+            for( auto& result : hook.result_c ){ hist_c.push_back( result.GetPtr() ); }
+            auto * canvas_h = hook.action( std::move(hist_c) );
+            if( canvas_h ){
+                //the results are held as long as the canvas drawing them
+                canvas_mc.push_back( canvas_h );
+                kept_mc.insert( kept_mc.end(), hook.result_c.begin(), hook.result_c.end() );
+            }
+            ++applied;
+        }
+        hook_mc = std::move(waiting_c);
+        return applied;
+    }
+
+    std::size_t rdf_styler::run() {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+        std::vector<ROOT::RDF::RResultHandle> handle_c;
+        for( auto& hook : hook_mc ){
+            for( auto& result : hook.result_c ){
+                if( !result.IsReady() ){ handle_c.emplace_back( result ); }
+            }
+        }
+        if( !handle_c.empty() ){ ROOT::RDF::RunGraphs( std::move(handle_c) ); }
+#else
+        //the first access starts the loop of its dataframe, which fills every other result booked on it
+        for( auto& hook : hook_mc ){
+            for( auto& result : hook.result_c ){
+                if( !result.IsReady() ){ result.GetValue(); }
+            }
+        }
+#endif
+        return flush();
+    }
+
+} //namespace iwir
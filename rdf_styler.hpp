@@ -0,0 +1,72 @@
+//
+//File      : rdf_styler.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef rdf_styler_h
+#define rdf_styler_h
+
+//iwir header
+#include "configurator.hpp"
+
+
+//std headers
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+//ROOT header
+#include "ROOT/RResultPtr.hxx"
+#include "TCanvas.h"
+#include "TH1.h"
+
+
+namespace iwir {
+
+    //configurations attached to booked RDataFrame results, applied once their event loop has filled them:
+    //attaching never starts a loop, and a single loop serves every hook booked on the same dataframe
+    //(only built when ROOT provides ROOT::ROOTDataFrame)
+    struct rdf_styler {
+        using result = ROOT::RDF::RResultPtr<TH1D>;
+
+    public:
+        //marker, line and axis attributes only, the i-th result taking the i-th hist1d entry
+        void style( std::vector<result> const& result_pc, std::string const& config_file_p );
+
+        //drawn together on one canvas, exported to output_p and deleted, or kept in canvases() when output_p is empty
+        void render( std::vector<result> const& result_pc,
+                     std::string const& config_file_p,
+                     std::string const& output_p = "" );
+
+        //applies every hook whose results are all filled, without starting any loop, returns how many were applied
+        std::size_t flush();
+
+        //starts the loops the pending results are still waiting for, each computation graph once
+        //(concurrently when ROOT provides RunGraphs), then flushes
+        std::size_t run();
+
+        std::size_t pending() const { return hook_mc.size(); }
+        std::vector<TCanvas*> const& canvases() const { return canvas_mc; }
+
+    private:
+        struct hook {
+            std::vector<result> result_c;
+            //returns the canvas to keep, if any
+            std::function< TCanvas*( std::vector<TH1D*>&& ) > action;
+        };
+
+    private:
+        std::vector<hook> hook_mc;
+        std::unordered_map< std::string, configurator::styler > styler_mc;
+        std::unordered_map< std::string, configurator::applier > applier_mc;
+        std::vector<TCanvas*> canvas_mc;
+        std::vector<result> kept_mc;
+    };
+
+} //namespace iwir
+
+#endif /* rdf_styler_h */
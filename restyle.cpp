@@ -0,0 +1,122 @@
+//
+//File      : restyle.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "restyle.hpp"
+#include "configurator.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TKey.h"
+
+namespace iwir {
+
+    namespace {
+        //bounds the number of histograms held in memory at once
+        constexpr std::size_t batch_size = 256;
+
+        struct located_key {
+            TKey* key_h;
+            TDirectory* directory_h;
+        };
+
+        //single pass over the directory tree, only the highest cycle of each name is kept (they are listed first)
+        void collect( TDirectory* directory_ph,
+                      std::string const& prefix_p,
+                      std::regex const& pattern_p,
+                      std::vector<located_key>& result_pc ) {
+            std::unordered_set<std::string> seen_c;
+            for( auto * object_h : *directory_ph->GetListOfKeys() ){
+                auto * key_h = static_cast<TKey*>( object_h );
+                if( !seen_c.insert( key_h->GetName() ).second ){ continue; }
+
+                auto * class_h = TClass::GetClass( key_h->GetClassName() );
+                if( !class_h ){ continue; }
+
+                auto path = prefix_p + key_h->GetName();
+                if( class_h->InheritsFrom( TDirectory::Class() ) ){
+                    auto * subdirectory_h = directory_ph->GetDirectory( key_h->GetName() );
+                    if( subdirectory_h ){ collect( subdirectory_h, path + "/", pattern_p, result_pc ); }
+                    continue;
+                }
+
+                if( class_h->InheritsFrom( TH1::Class() ) && std::regex_match( path, pattern_p ) ){
+                    result_pc.push_back( located_key{ key_h, directory_ph } );
+                }
+            }
+        }
+    } //namespace
+
+
+    std::size_t restyle_file( std::string const& config_file_p,
+                              std::string const& root_file_p,
+                              std::string const& pattern_p ) {
+        auto styler = configurator{}.prepare_style( config_file_p );
+        if( !styler ){ return 0; }
+
+        std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str(), "UPDATE" ) };
+        if( !file_h || file_h->IsZombie() || !file_h->IsWritable() ){
+            std::cerr << "Could not open file for update: " << root_file_p << "\n";
+            return 0;
+        }
+
+        std::vector<located_key> key_c;
+        collect( file_h.get(), "", std::regex{ pattern_p }, key_c );
+
+        //reading in file order keeps the accesses sequential
+        std::sort( key_c.begin(), key_c.end(),
+                   []( located_key const& lhs_p, located_key const& rhs_p )
+                   { return lhs_p.key_h->GetSeekKey() < rhs_p.key_h->GetSeekKey(); } );
+
+        std::vector<TH1*> hist_c;
+        hist_c.reserve( batch_size );
+        std::vector<TDirectory*> directory_c;
+        directory_c.reserve( batch_size );
+        //written back under the name of its key, which may differ from the one of the object
+        //(copied: WriteDelete frees the key)
+        std::vector<std::string> key_name_c;
+        key_name_c.reserve( batch_size );
+
+        std::size_t restyled{0};
+        for( std::size_t first{0} ; first < key_c.size() ; first += batch_size ){
+            auto last = std::min( first + batch_size, key_c.size() );
+
+            hist_c.clear();
+            directory_c.clear();
+            key_name_c.clear();
+            for( auto index = first ; index < last ; ++index ){
+                auto * hist_h = dynamic_cast<TH1*>( key_c[index].key_h->ReadObj() );
+                if( !hist_h ){ continue; }
+                hist_c.push_back( hist_h );
+                directory_c.push_back( key_c[index].directory_h );
+                key_name_c.emplace_back( key_c[index].key_h->GetName() );
+            }
+
+            styler( hist_c, restyled );
+
+            //replaces the previous cycle of that very key, the key lists are only written once, when closing
+            //(only the highest cycle of each name in a directory is collected, no later batch holds the deleted key)
+            for( std::size_t i{0} ; i < hist_c.size() ; ++i ){
+                directory_c[i]->WriteTObject( hist_c[i], key_name_c[i].c_str(), "WriteDelete" );
+                delete hist_c[i];
+            }
+            restyled += hist_c.size();
+        }
+
+        file_h->Close();
+        return restyled;
+    }
+
+} //namespace iwir
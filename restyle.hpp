@@ -0,0 +1,26 @@
+//
+//File      : restyle.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef restyle_h
+#define restyle_h
+
+//std headers
+#include <string>
+
+
+namespace iwir {
+
+    //applies the histogram style of config_file_p to every TH1 of root_file_p whose path inside the file
+    //("name" or "directory/name") matches the regular expression pattern_p, and writes them back in place
+    //returns the number of restyled histograms
+    std::size_t restyle_file( std::string const& config_file_p,
+                              std::string const& root_file_p,
+                              std::string const& pattern_p );
+
+} //namespace iwir
+
+#endif /* restyle_h */
@@ -0,0 +1,92 @@
+//
+//File      : root_context.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "root_context.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iostream>
+#include <new>
+
+#include <pthread.h>
+
+#include "TROOT.h"
+
+namespace iwir {
+
+    namespace {
+        //filled without any lock: registration happens under the very mutexes taken at fork
+        constexpr std::size_t fork_mutex_capacity = 32;
+        std::array< std::atomic<std::mutex*>, fork_mutex_capacity > fork_mutex_c{};
+        std::atomic<std::size_t> fork_mutex_count{0};
+
+        std::size_t fork_mutex_size() { return std::min( fork_mutex_count.load(), fork_mutex_capacity ); }
+
+        void prepare_fork() {
+            root_mutex().lock();
+            for( std::size_t i{0} ; i < fork_mutex_size() ; ++i ){
+                if( auto * mutex_h = fork_mutex_c[i].load() ){ mutex_h->lock(); }
+            }
+        }
+
+        void resume_parent() {
+            for( auto i = fork_mutex_size() ; i-- > 0 ; ){
+                if( auto * mutex_h = fork_mutex_c[i].load() ){ mutex_h->unlock(); }
+            }
+            root_mutex().unlock();
+        }
+
+        //the only thread of the child is not the owner the locks recorded: they are set back to their initial state
+        void resume_child() {
+            for( std::size_t i{0} ; i < fork_mutex_size() ; ++i ){
+                if( auto * mutex_h = fork_mutex_c[i].load() ){ new (mutex_h) std::mutex{}; }
+            }
+            new (&root_mutex()) std::recursive_mutex{};
+        }
+    } //namespace
+
+
+    std::recursive_mutex& root_mutex() {
+        static std::recursive_mutex mutex;
+        static bool const fork_handled = ( pthread_atfork( &prepare_fork, &resume_parent, &resume_child ) == 0 );
+        (void)fork_handled;
+        return mutex;
+    }
+
+    void hold_across_fork( std::mutex& mutex_p ) {
+        root_mutex();
+        auto const index = fork_mutex_count++;
+        if( index >= fork_mutex_capacity ){
+            std::cerr << "Too many mutexes to hold across fork, raise fork_mutex_capacity\n";
+            return;
+        }
+        fork_mutex_c[index] = &mutex_p;
+    }
+
+    lookup_context lookup_context::current() {
+        root_guard guard{ root_mutex() };
+
+        lookup_context result;
+        result.directory_h = TDirectory::CurrentDirectory();
+        for( auto * file_h : *gROOT->GetListOfFiles() ){ result.file_c.push_back( static_cast<TFile*>( file_h ) ); }
+        return result;
+    }
+
+    std::unique_ptr<TFile> open_private( std::string const& file_name_p ) {
+        root_guard guard{ root_mutex() };
+
+        std::unique_ptr<TFile> file_h{ TFile::Open( file_name_p.c_str() ) };
+        if( !file_h || file_h->IsZombie() ){
+            std::cerr << "Could not open file: " << file_name_p << "\n";
+            return nullptr;
+        }
+        gROOT->GetListOfFiles()->Remove( file_h.get() );
+        return file_h;
+    }
+
+} //namespace iwir
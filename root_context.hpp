@@ -0,0 +1,54 @@
+//
+//File      : root_context.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef root_context_h
+#define root_context_h
+
+//std headers
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+//ROOT header
+#include "TDirectory.h"
+#include "TFile.h"
+
+
+namespace iwir {
+
+    //held by iwir whenever ROOT global state is involved: gROOT lists, gDirectory, gPad, canvas creation
+    //and drawing, as well as reads through shared file handles
+    //reading and filling configurations, and writing them out, never take it: they only work on iwir images
+    //threads of the caller touching the same state concurrently should hold it as well
+    //(ROOT::EnableThreadSafety has to be called beforehand in any case)
+    std::recursive_mutex& root_mutex();
+    using root_guard = std::lock_guard<std::recursive_mutex>;
+
+    //mutexes of iwir that its own threads take (saver, async worker, caches): every one registered here is taken,
+    //after root_mutex(), before any fork() of the process and released after it, so that a child never starts with
+    //one held by a thread it does not have; the child gets them back unlocked. root_mutex() is never to be taken
+    //while one of them is held
+    void hold_across_fork( std::mutex& mutex_p );
+
+    //where histograms are looked for, given explicitly rather than taken from the globals at each lookup
+    struct lookup_context {
+        //current directory and files opened in the session, as seen by the calling thread
+        static lookup_context current();
+
+        TDirectory* directory_h{nullptr};    //its in-memory objects are looked at first, skipped when nullptr
+        std::vector<TFile*> file_c;
+    };
+
+    //read only handle for a single thread, kept out of gROOT's list of files so that lookup_context::current()
+    //never hands it over to another one, nullptr when the file cannot be opened
+    std::unique_ptr<TFile> open_private( std::string const& file_name_p );
+
+} //namespace iwir
+
+#endif /* root_context_h */
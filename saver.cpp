@@ -7,7 +7,17 @@
 
 #include "saver.hpp"
 #include "flag_set.hpp"
+#include "root_context.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <sys/stat.h>
 
 
 
@@ -26,9 +36,11 @@ namespace iwir {
     constexpr details::constexpr_string<6> header<T>::anchor;
     
     constexpr details::constexpr_string<17> legend_attributes::anchor;
+    constexpr details::constexpr_string<8> selector::anchor;
     constexpr details::constexpr_string<6> option::anchor;
     constexpr details::constexpr_string<4> line::anchor;
     constexpr details::constexpr_string<6> marker::anchor;
+    constexpr details::constexpr_string<8> sampling::anchor;
 
     
     
@@ -38,21 +50,229 @@ namespace iwir {
     constexpr details::constexpr_string<3> pad::anchor;
     constexpr details::constexpr_string<6> histogram1d::anchor;
     constexpr details::constexpr_string<7> frame1d::anchor;
+    constexpr details::constexpr_string<5> graph::anchor;
 
     
     
     
+    namespace {
+        
+        struct file_status {
+            long long modification_ns{-1};
+            long long size{-1};
+            
+            bool operator==( file_status const& other_p ) const {
+                return modification_ns == other_p.modification_ns && size == other_p.size;
+            }
+        };
+        
+        file_status status_of( std::string const& file_p ){
+            struct stat status;
+            if( stat( file_p.c_str(), &status ) != 0 ){ return {}; }
+            //to the nanosecond: a file rewritten within the same second with the same size is still told apart
+            return { static_cast<long long>( status.st_mtim.tv_sec ) * 1000000000LL + status.st_mtim.tv_nsec,
+                     static_cast<long long>( status.st_size ) };
+        }
+        
+        //what was last given for a canvas and a file
+        struct saved_file {
+            uint8_t opcode;
+            std::vector<std::string> element_content_c;
+            unsigned long generation;
+            bool written;           //false as long as the write is queued
+            file_status status;     //as left by that write, a different one meaning the file was changed by someone else
+        };
+        
+        
+        //single thread writing files in the background, a newer content for a file still queued replacing the older one
+        //never touches ROOT: it can be joined at exit, so that no save is lost
+        struct file_writer {
+            //called after each write, whether it succeeded or not
+            using written_callback = void(*)( std::string const&, unsigned long, bool, file_status );
+            
+            explicit file_writer( written_callback callback_p ) : callback_m{ callback_p },
+                                                                   thread_m{ [this](){ run(); } } {
+                hold_across_fork( mutex_m );
+            }
+            
+            ~file_writer() {
+                {
+                    std::lock_guard<std::mutex> lock{ mutex_m };
+                    stop_m = true;
+                }
+                condition_m.notify_all();
+                thread_m.join();
+            }
+            
+            void push( std::string const& file_p, std::string content_p, unsigned long generation_p ) {
+                {
+                    std::lock_guard<std::mutex> lock{ mutex_m };
+                    pending_mc[ file_p ] = job{ std::move(content_p), generation_p };
+                }
+                condition_m.notify_all();
+            }
+            
+            void wait() {
+                std::unique_lock<std::mutex> lock{ mutex_m };
+                condition_m.wait( lock, [this](){ return pending_mc.empty() && !busy_m; } );
+            }
+            
+        private:
+            struct job {
+                std::string content;
+                unsigned long generation;
+            };
+            
+            void run() {
+                std::unique_lock<std::mutex> lock{ mutex_m };
+                while( true ){
+                    condition_m.wait( lock, [this](){ return stop_m || !pending_mc.empty(); } );
+                    if( pending_mc.empty() ){ return; }
+                    
+                    auto job_i = pending_mc.begin();
+                    auto file = job_i->first;
+                    auto current = std::move( job_i->second );
+                    pending_mc.erase( job_i );
+                    busy_m = true;
+                    
+                    lock.unlock();
+                    auto const written = write( file, current.content );
+                    callback_m( file, current.generation, written, written ? status_of( file ) : file_status{} );
+                    lock.lock();
+                    
+                    busy_m = false;
+                    condition_m.notify_all();
+                }
+            }
+            
+            //readers of the file see either the previous content or the new one, never a partial write
+            static bool write( std::string const& file_p, std::string const& content_p ) {
+                auto const temporary_file = file_p + ".iwir-tmp";
+                {
+                    std::ofstream output{ temporary_file.c_str(), std::ios::out | std::ios::trunc };
+                    output << content_p;
+                    output.close();
+                    if( !output ){
+                        std::cerr << "Something went wrong with the output file: " << file_p << '\n';
+                        std::remove( temporary_file.c_str() );
+                        return false;
+                    }
+                }
+                if( std::rename( temporary_file.c_str(), file_p.c_str() ) != 0 ){
+                    std::cerr << "Could not replace: " << file_p << '\n';
+                    std::remove( temporary_file.c_str() );
+                    return false;
+                }
+                return true;
+            }
+            
+        private:
+            written_callback callback_m;
+            std::mutex mutex_m;
+            std::condition_variable condition_m;
+            std::map< std::string, job > pending_mc;
+            bool busy_m{false};
+            bool stop_m{false};
+            std::thread thread_m;
+        };
+        
+        
+        std::mutex& saved_mutex() {
+            static std::mutex mutex;
+            static bool const fork_held = ( hold_across_fork( mutex ), true );
+            (void)fork_held;
+            return mutex;
+        }
+        
+        //canvases are never told to the saver when deleted: past that count, the oldest save is forgotten
+        constexpr std::size_t saved_file_count = 1024;
+        
+        std::map< std::pair<TCanvas const*, std::string>, saved_file >& saved_files() {
+            static std::map< std::pair<TCanvas const*, std::string>, saved_file > saved_c;
+            return saved_c;
+        }
+        
+        //a failed write is forgotten, so that the next save of the same content tries again
+        void on_written( std::string const& file_p, unsigned long generation_p, bool written_p, file_status status_p ) {
+            std::lock_guard<std::mutex> lock{ saved_mutex() };
+            auto& saved_c = saved_files();
+            for( auto saved_i = saved_c.begin() ; saved_i != saved_c.end() ; ){
+                if( saved_i->first.second != file_p || saved_i->second.generation != generation_p ){ ++saved_i; continue; }
+                if( !written_p ){ saved_i = saved_c.erase( saved_i ); continue; }
+                saved_i->second.written = true;
+                saved_i->second.status = status_p;
+                ++saved_i;
+            }
+        }
+        
+        //constructed after the registry it reports to, hence destroyed, and joined, before it
+        file_writer& writer() {
+            saved_mutex();
+            saved_files();
+            static file_writer writer{ &on_written };
+            return writer;
+        }
+    }
+    
+    
+    void saver::flush() {
+        writer().wait();
+    }
+    
+    void saver::commit( TCanvas const* canvas_ph,
+                        std::string const& output_filename_p,
+                        uint8_t opcode_p,
+                        std::vector<std::string>&& element_content_pc ) const {
+        static unsigned long generation{0};
+        std::lock_guard<std::mutex> lock{ saved_mutex() };
+        auto& saved_c = saved_files();
+        
+        auto saved_i = saved_c.find( std::make_pair( canvas_ph, output_filename_p ) );
+        if( saved_i != saved_c.end() && saved_i->second.opcode == opcode_p ){
+            auto const& saved = saved_i->second;
+            auto const unchanged = saved.element_content_c == element_content_pc;
+            //a file edited or removed since it was written is written again, whatever the canvas
+            if( unchanged && ( !saved.written || status_of( output_filename_p ) == saved.status ) ){ return; }
+        }
+        
+        //a text file has no fixed offsets to patch in place: once an element changed, the whole file is written again
+        std::string content;
+        for( auto const& element_content : element_content_pc ){ content += element_content; }
+        
+        //the same file saved from another canvas is not known to hold its content anymore
+        for( auto& saved : saved_c ){
+            if( saved.first.second == output_filename_p ){ saved.second.written = true; saved.second.status = {}; }
+        }
+        saved_c[ std::make_pair( canvas_ph, output_filename_p ) ] =
+                    saved_file{ opcode_p, std::move(element_content_pc), ++generation, false, {} };
+        if( saved_c.size() > saved_file_count ){
+            using entry = std::pair< std::pair<TCanvas const*, std::string> const, saved_file >;
+            saved_c.erase( std::min_element( saved_c.begin(), saved_c.end(),
+                                             []( entry const& lhs_p, entry const& rhs_p )
+                                             { return lhs_p.second.generation < rhs_p.second.generation; } ) );
+        }
+        writer().push( output_filename_p, std::move(content), generation );
+    }
+    
+    
     void saver::operator()(TCanvas const* canvas_ph, std::string output_filename_p) const {
         
+        //the canvas is only read while the lock is held, the image is written out once it is released
+        std::unique_lock<std::recursive_mutex> lock{ root_mutex() };
+        
         uint8_t opcode{};
         auto const& primitive_c = *canvas_ph->GetListOfPrimitives();
         for( auto const* primitive_h : primitive_c ) {
             if( std::string{primitive_h->ClassName()} == "TPaveText"  ){ opcode |= flag_set<pave_text_flag>{};  }
             if( std::string{primitive_h->ClassName()} ==  "TLegend"  ){ opcode |= flag_set<legend_flag>{}; }
             if( primitive_h->InheritsFrom( TH1::Class() )  ){ opcode |= flag_set<hist1d_flag>{}; }
+            if( primitive_h->InheritsFrom( TGraph::Class() )  ){ opcode |= flag_set<graph_flag>{}; }
 //            if( primitive_h->InheritsFrom( TH2::Class() )  ){ opcode |= 1U << 3; }
         }
         
+        monotonic_arena arena;
+        arena_scope scope{ arena };
+        
         switch( opcode ) {
 //        case 0b1001: {
 //            auto config = make_image< configuration< histogram2d, text > >();
@@ -73,26 +293,59 @@ namespace iwir {
         case flag_set<hist1d_flag, legend_flag, pave_text_flag>{} :{
             auto config = make_image< configuration< frame1d, histogram1d, legend, pave_text > >();
             config = fill(std::move(config), canvas_ph);
-            write( output_filename_p, std::move(config)  );
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
             break;
         }
                 //legend should always comme after histogram
         case flag_set<hist1d_flag, legend_flag>{} :{
             auto config = make_image< configuration< frame1d, histogram1d, legend > >();
             config = fill(std::move(config), canvas_ph);
-            write( output_filename_p, std::move(config)  );
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
             break;
         }
         case flag_set<hist1d_flag, pave_text_flag>{} :{
             auto config = make_image< configuration< frame1d, histogram1d, pave_text > >();
             config = fill(std::move(config), canvas_ph);
-            write( output_filename_p, std::move(config)  );
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
             break;
         }
         case flag_set<hist1d_flag>{} :{
             auto config = make_image< configuration< frame1d, histogram1d> >();
             config = fill(std::move(config), canvas_ph);
-            write( output_filename_p, std::move(config)  );
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
+            break;
+        }
+                //frame taken from the axes of the graphs
+        case flag_set<graph_flag, legend_flag, pave_text_flag>{} :{
+            auto config = make_image< configuration< frame1d, graph, legend, pave_text > >();
+            config = fill(std::move(config), canvas_ph);
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
+            break;
+        }
+        case flag_set<graph_flag, legend_flag>{} :{
+            auto config = make_image< configuration< frame1d, graph, legend > >();
+            config = fill(std::move(config), canvas_ph);
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
+            break;
+        }
+        case flag_set<graph_flag, pave_text_flag>{} :{
+            auto config = make_image< configuration< frame1d, graph, pave_text > >();
+            config = fill(std::move(config), canvas_ph);
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
+            break;
+        }
+        case flag_set<graph_flag>{} :{
+            auto config = make_image< configuration< frame1d, graph > >();
+            config = fill(std::move(config), canvas_ph);
+            lock.unlock();
+            store( canvas_ph, output_filename_p, opcode, config );
             break;
         }
         default: {
@@ -15,10 +15,13 @@
 
 //std headers
 #include <fstream>
+#include <string>
+#include <vector>
 
 
 //ROOT header
 #include "TCanvas.h"
+#include "TGraph.h"
 #include "TH1.h"
 #include "TH2.h"
 #include "TPaveText.h"
@@ -34,8 +37,13 @@ namespace iwir {
 struct saver{
     
 public:
+    //the canvas is read on the calling thread, the file is written by a background one, atomically (temporary file, then rename)
+    //saving the same canvas to the same file again writes nothing when no element changed
     void operator()(TCanvas const* canvas_ph, std::string output_filename_p) const;
     
+    //waits until every file given so far has been written
+    static void flush();
+    
 private:
     template< class ... Ts>
     image< configuration<Ts...> > fill( image< configuration<Ts...> >&& image_p,
@@ -127,30 +135,39 @@ private:
 
                 
                 auto const& entry_c = *legend_h->GetListOfPrimitives();
-                auto & hist_element = image_p.template retrieve_element<histogram1d>();
-                
                 for( auto const* entry_h : entry_c ){
                     auto const * legend_entry_h = dynamic_cast<TLegendEntry const*>( entry_h );
-                        auto* obj_h = legend_entry_h->GetObject();
-                        if(obj_h){
-                            std::string hist_name = obj_h->GetName();
-                            for( auto & hist : hist_element ){
-                                auto const& name_field = hist.template retrieve_field<name>();
-                                if( hist_name == name_field.retrieve().value() ){
-                                    auto & legend_field = hist.template retrieve_field<legend_attributes>();
-                                    legend_field.template fill<user_text, plain_text>(
-                                                legend_entry_h->GetLabel(),
-                                                legend_entry_h->GetOption()
-                                                                              );
-                                }
-                            }
-                        }
+                    if( legend_entry_h && legend_entry_h->GetObject() ){
+                        label_entries<histogram1d>( image_p, legend_entry_h );
+                        label_entries<graph>( image_p, legend_entry_h );
+                    }
                 }
             }
         }
         return std::move(image_p);
     }
     
+    //entries of Element named as the object of the legend entry take its label, when the configuration holds Element
+    template< class Element, class ... Ts,
+              typename std::enable_if_t< holds_element<Element>( configuration<Ts...>{} ), std::nullptr_t> = nullptr >
+    void label_entries( image< configuration<Ts...> >& image_p, TLegendEntry const* legend_entry_ph ) const {
+        std::string object_name = legend_entry_ph->GetObject()->GetName();
+        for( auto&& entry : image_p.template retrieve_element<Element>() ){
+            auto const& name_field = entry.template retrieve_field<name>();
+            if( object_name == name_field.retrieve().plain_data() ){
+                auto & legend_field = entry.template retrieve_field<legend_attributes>();
+                legend_field.template fill<user_text, plain_text>(
+                            legend_entry_ph->GetLabel(),
+                            legend_entry_ph->GetOption()
+                                                          );
+            }
+        }
+    }
+    
+    template< class Element, class ... Ts,
+              typename std::enable_if_t< !holds_element<Element>( configuration<Ts...>{} ), std::nullptr_t> = nullptr >
+    void label_entries( image< configuration<Ts...> >& /*image_p*/, TLegendEntry const* /*legend_entry_ph*/ ) const {}
+    
     template< class ... Ts >
     image< configuration<Ts...> > fill_element( image< configuration<Ts...> >&& image_p,
                                                 TCanvas const* canvas_ph,
@@ -160,7 +177,7 @@ private:
         while( (object_h = primitive_i.Next()) ) {
             if( object_h->InheritsFrom( TH1::Class() )  ){
                 auto const * histogram_h = dynamic_cast<TH1 const*>( object_h );
-                auto & histogram = image_p.template retrieve_element<histogram1d>().add_value();
+                auto histogram = image_p.template retrieve_element<histogram1d>().add_value();
                 
                 auto & name_field = histogram.template retrieve_field<name>();
                 name_field.template fill<plain_text>( histogram_h->GetName() );
@@ -188,6 +205,43 @@ private:
     }
     
     
+    template< class ... Ts >
+    image< configuration<Ts...> > fill_element( image< configuration<Ts...> >&& image_p,
+                                                TCanvas const* canvas_ph,
+                                                graph ) const {
+        TIter primitive_i = canvas_ph->GetListOfPrimitives(); //needed to access GetOption()
+        TObject const* object_h = nullptr;
+        while( (object_h = primitive_i.Next()) ) {
+            if( object_h->InheritsFrom( TGraph::Class() )  ){
+                auto const * graph_h = dynamic_cast<TGraph const*>( object_h );
+                auto & graph_element = image_p.template retrieve_element<graph>().add_value();
+                
+                auto & name_field = graph_element.template retrieve_field<name>();
+                name_field.template fill<plain_text>( graph_h->GetName() );
+                
+                auto & option_field = graph_element.template retrieve_field<option>();
+                option_field.template fill<plain_text>( primitive_i.GetOption() );
+                
+                auto & marker_field = graph_element.template retrieve_field<marker>();
+                marker_field.template fill<size, style, color>(
+                                        graph_h->GetMarkerSize(),
+                                        graph_h->GetMarkerStyle(),
+                                        graph_h->GetMarkerColor()
+                                                               );
+                
+                auto & line_field = graph_element.template retrieve_field<line>();
+                line_field.template fill<width, style, color>(
+                                        graph_h->GetLineWidth(),
+                                        graph_h->GetLineStyle(),
+                                        graph_h->GetLineColor()
+                                                               );
+                //sampling is never read from the canvas: it is chosen in the configuration
+            }
+        }
+        return std::move(image_p);
+    }
+    
+    
     template< class ... Ts >
     image< configuration<Ts...> > fill_element( image< configuration<Ts...> >&& image_p,
                                                 TCanvas const* canvas_ph,
@@ -254,6 +308,22 @@ private:
             }
         }
         
+        //graphs draw their axes on a histogram of their own, whose bins do not relate to the plot:
+        //the range is kept in user coordinates, as shown on the canvas
+        for( auto const* primitive_h : primitive_c ) {
+            if( primitive_h->InheritsFrom( TGraph::Class() )  ){
+                auto const * graph_h = dynamic_cast<TGraph const*>( primitive_h );
+                if( !graph_h->GetHistogram() ){ continue; }
+                fill_using( graph_h->GetHistogram() );
+                
+                auto & frame_element = image_p.template retrieve_element<frame1d>();
+                frame_element.template retrieve_field< range<x> >().template fill<low, high>( canvas_ph->GetUxmin(),
+                                                                                              canvas_ph->GetUxmax() );
+                frame_element.template retrieve_field< range<y> >().template fill<low, high>( canvas_ph->GetUymin(),
+                                                                                              canvas_ph->GetUymax() );
+                return std::move(image_p);
+            }
+        }
 
         return std::move(image_p);
     }
@@ -269,15 +339,23 @@ private:
 //        return std::move(image_p);
 //    }
     
+    //formatted element by element, so that the next save of the same canvas to the same file can be compared with it
     template<class ... Ts>
-    void write( std::string const& output_filename_p,
-                          image<Ts...> config_p ) const {
-        std::ofstream output{ output_filename_p.c_str(), std::ios::out | std::ios::trunc };
-        if( !output.good() ){
-            std::cerr << "Something went wrong with the output file\n";
-        }
-        output << config_p.retrieve_content();
+    void store( TCanvas const* canvas_ph,
+                std::string const& output_filename_p,
+                uint8_t opcode_p,
+                image< configuration<Ts...> > const& config_p ) const {
+        std::vector<std::string> element_content_c{
+                        config_p.template retrieve_element<pad>().retrieve_content(),
+                        config_p.template retrieve_element<Ts>().retrieve_content()...
+                                                    };
+        commit( canvas_ph, output_filename_p, opcode_p, std::move(element_content_c) );
     }
+    
+    void commit( TCanvas const* canvas_ph,
+                 std::string const& output_filename_p,
+                 uint8_t opcode_p,
+                 std::vector<std::string>&& element_content_pc ) const;
 };
     
     
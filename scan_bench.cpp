@@ -0,0 +1,80 @@
+//
+//File      : scan_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//throughput of the first stage of the configurator on synthetic configurations, against the byte after byte pass
+//usage: iwir-scan-bench [size_mb] [repetition_count]
+
+
+#include "scanner.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+    //hist1d entries as saver writes them, indented, with a user text each
+    std::string synthetic_configuration( std::size_t size_p ) {
+        std::string result;
+        result.reserve( size_p + 512 );
+        for( std::size_t entry{0} ; result.size() < size_p ; ++entry ){
+            result += "\n<hist1d>\n"
+                      "    <marker>\n        style:=20\n        color:=" + std::to_string( entry % 50 ) + "\n        size:=1.2\n    <marker>\n"
+                      "    <line>\n        style:=1\n        color:=" + std::to_string( entry % 50 ) + "\n        width:=2\n    <line>\n"
+                      "    <option>\n        plain_text:=hist\n    <option>\n"
+                      "    <name>\n        user_text:=[h_" + std::to_string( entry ) + " pt, |#eta| < 2.4]\n    <name>\n"
+                      "<hist1d>\n";
+        }
+        return result;
+    }
+
+    template<class Strip>
+    double measure( std::string const& content_p, unsigned repetition_count_p, Strip strip_p, std::size_t& size_p ) {
+        double best{0};
+        for( unsigned i{0} ; i < repetition_count_p ; ++i ){
+            auto content = content_p;
+            auto const start = std::chrono::steady_clock::now();
+            strip_p( content );
+            std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+            size_p = content.size();
+            best = std::max( best, content_p.size() / elapsed.count() * 1e-9 );
+        }
+        return best;
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    std::size_t const size_mb = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 64;
+    unsigned const repetition_count = argc > 2 ? std::strtoul( argv[2], nullptr, 10 ) : 10;
+    if( !size_mb || !repetition_count ){
+        std::cerr << "usage: iwir-scan-bench [size_mb] [repetition_count]\n";
+        return 1;
+    }
+
+    auto const content = synthetic_configuration( size_mb << 20 );
+
+    std::size_t stripped_size{0}, reference_size{0};
+    auto const scanner = measure( content, repetition_count,
+                                  []( std::string& content_p ){ iwir::strip_whitespace( content_p ); }, stripped_size );
+    //the former pass, which took user texts out beforehand
+    auto const reference = measure( content, repetition_count, []( std::string& content_p ){
+        content_p.erase( std::remove_if( content_p.begin(), content_p.end(),
+                                         []( unsigned char c ){ return std::isspace(c); } ),
+                         content_p.end() );
+    }, reference_size );
+
+    std::cout << "configuration: " << content.size() / double(1 << 20) << " MB, "
+              << stripped_size / double(1 << 20) << " MB once stripped\n"
+              << "scanner (" << iwir::scanner_kind() << "): " << scanner << " GB/s\n"
+              << "remove_if(isspace): " << reference << " GB/s\n";
+    return 0;
+}
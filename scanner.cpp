@@ -0,0 +1,213 @@
+//
+//File      : scanner.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "scanner.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IWIR_SCANNER_X86
+#include <immintrin.h>
+#endif
+
+namespace iwir {
+
+    namespace {
+
+        //what std::isspace accepts in the "C" locale: ' ', and '\t' to '\r'
+        bool is_space( unsigned char c ) { return c == ' ' || static_cast<unsigned char>( c - '\t' ) <= '\r' - '\t'; }
+
+        //the classification of one block, bit i standing for its i-th byte
+        struct block_class {
+            std::uint32_t space;
+            std::uint32_t text_opening;
+        };
+
+        struct scalar_block {
+            static constexpr std::size_t width = 1;
+            static block_class classify( char const* input_ph ) {
+                return { is_space( *input_ph ) ? 1u : 0u, *input_ph == '[' ? 1u : 0u };
+            }
+            static char* compact( char const* input_ph, std::uint32_t space_p, char* output_ph ) {
+                if( !space_p ){ *output_ph++ = *input_ph; }
+                return output_ph;
+            }
+        };
+
+        //moves down the first count_p bytes of the block which are not whitespace, one at a time
+        char* compact_prefix( char const* input_ph, std::uint32_t space_p, std::size_t count_p, char* output_ph ) {
+            std::uint32_t keep = ~space_p & ( (std::uint32_t{1} << count_p) - 1 );
+            while( keep ){
+                *output_ph++ = input_ph[ __builtin_ctz( keep ) ];
+                keep &= keep - 1;
+            }
+            return output_ph;
+        }
+
+        //the bytes of the block are never read after being overwritten: output_ph never goes past input_ph,
+        //and a whole block is loaded before any of it is stored
+        template<class Block>
+        std::size_t strip_blocks( char* data_ph, std::size_t size_p ) {
+            char const* input_h = data_ph;
+            char const* const end_h = data_ph + size_p;
+            char* output_h = data_ph;
+            bool texts_closed{true};
+
+            auto strip_bytes = [&]( std::size_t count_p ){
+                for( auto const* block_end_h = input_h + count_p ; input_h != block_end_h ; ++input_h ){
+                    if( !is_space( *input_h ) ){ *output_h++ = *input_h; }
+                }
+            };
+            //copies the user text opening at input_h, false when it is never closed
+            auto copy_text = [&](){
+                auto const* closing_h = static_cast<char const*>( std::memchr( input_h, ']', end_h - input_h ) );
+                if( !closing_h ){ return false; }
+                auto const length = static_cast<std::size_t>( closing_h + 1 - input_h );
+                std::memmove( output_h, input_h, length );
+                output_h += length;
+                input_h += length;
+                return true;
+            };
+
+            while( static_cast<std::size_t>( end_h - input_h ) >= Block::width ){
+                auto const block = Block::classify( input_h );
+                auto const opening = texts_closed ? block.text_opening : 0;
+                if( !opening ){
+                    output_h = Block::compact( input_h, block.space, output_h );
+                    input_h += Block::width;
+                    continue;
+                }
+
+                auto const before = static_cast<std::size_t>( __builtin_ctz( opening ) );
+                output_h = compact_prefix( input_h, block.space, before, output_h );
+                input_h += before;
+                //nothing after an unclosed text can close one either
+                texts_closed = copy_text();
+            }
+
+            //tail shorter than a block
+            while( input_h != end_h ){
+                if( texts_closed && *input_h == '[' && (texts_closed = copy_text()) ){ continue; }
+                strip_bytes( 1 );
+            }
+            return static_cast<std::size_t>( output_h - data_ph );
+        }
+
+#ifdef IWIR_SCANNER_X86
+
+        //bytes equal to ' ', or within '\t' and '\r', their distance to '\t' being unsigned
+        struct sse2_block {
+            static constexpr std::size_t width = 16;
+            static block_class classify( char const* input_ph ) {
+                auto const bytes = _mm_loadu_si128( reinterpret_cast<__m128i const*>( input_ph ) );
+                auto const shifted = _mm_sub_epi8( bytes, _mm_set1_epi8( '\t' ) );
+                auto const control = _mm_cmpeq_epi8( _mm_min_epu8( shifted, _mm_set1_epi8( '\r' - '\t' ) ), shifted );
+                auto const space = _mm_or_si128( control, _mm_cmpeq_epi8( bytes, _mm_set1_epi8( ' ' ) ) );
+                auto const opening = _mm_cmpeq_epi8( bytes, _mm_set1_epi8( '[' ) );
+                return { static_cast<std::uint32_t>( _mm_movemask_epi8( space ) ),
+                         static_cast<std::uint32_t>( _mm_movemask_epi8( opening ) ) };
+            }
+            static char* compact( char const* input_ph, std::uint32_t space_p, char* output_ph ) {
+                if( !space_p ){
+                    _mm_storeu_si128( reinterpret_cast<__m128i*>( output_ph ),
+                                      _mm_loadu_si128( reinterpret_cast<__m128i const*>( input_ph ) ) );
+                    return output_ph + width;
+                }
+                return compact_prefix( input_ph, space_p, width, output_ph );
+            }
+        };
+
+        //for each set of 8 kept bits, the shuffle gathering the kept bytes at the front
+        std::array< std::uint64_t, 256 > const& gather_table() {
+            static auto const table = [](){
+                std::array< std::uint64_t, 256 > result_c{};
+                for( unsigned keep{0} ; keep < 256 ; ++keep ){
+                    unsigned position{0};
+                    for( unsigned i{0} ; i < 8 ; ++i ){
+                        if( keep & (1u << i) ){ result_c[keep] |= std::uint64_t{i} << (8 * position++); }
+                    }
+                }
+                return result_c;
+            }();
+            return table;
+        }
+
+        struct avx2_block {
+            static constexpr std::size_t width = 32;
+            __attribute__((target("avx2")))
+            static block_class classify( char const* input_ph ) {
+                auto const bytes = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( input_ph ) );
+                auto const shifted = _mm256_sub_epi8( bytes, _mm256_set1_epi8( '\t' ) );
+                auto const control = _mm256_cmpeq_epi8( _mm256_min_epu8( shifted, _mm256_set1_epi8( '\r' - '\t' ) ), shifted );
+                auto const space = _mm256_or_si256( control, _mm256_cmpeq_epi8( bytes, _mm256_set1_epi8( ' ' ) ) );
+                auto const opening = _mm256_cmpeq_epi8( bytes, _mm256_set1_epi8( '[' ) );
+                return { static_cast<std::uint32_t>( _mm256_movemask_epi8( space ) ),
+                         static_cast<std::uint32_t>( _mm256_movemask_epi8( opening ) ) };
+            }
+            //each quarter of the block is gathered by one shuffle, and stored whole: the bytes beyond the kept ones
+            //land where the next quarter goes
+            __attribute__((target("avx2")))
+            static char* compact( char const* input_ph, std::uint32_t space_p, char* output_ph ) {
+                auto const bytes = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( input_ph ) );
+                if( !space_p ){
+                    _mm256_storeu_si256( reinterpret_cast<__m256i*>( output_ph ), bytes );
+                    return output_ph + width;
+                }
+
+                auto const& table = gather_table();
+                __m128i const lane_c[2] = { _mm256_castsi256_si128( bytes ), _mm256_extracti128_si256( bytes, 1 ) };
+                auto const keep = ~space_p;
+                for( unsigned quarter{0} ; quarter < 4 ; ++quarter ){
+                    auto const quarter_keep = (keep >> (8 * quarter)) & 0xff;
+                    auto lane = lane_c[ quarter / 2 ];
+                    if( quarter % 2 ){ lane = _mm_srli_si128( lane, 8 ); }
+                    auto const gathered = _mm_shuffle_epi8( lane, _mm_loadl_epi64( reinterpret_cast<__m128i const*>( &table[ quarter_keep ] ) ) );
+                    _mm_storel_epi64( reinterpret_cast<__m128i*>( output_ph ), gathered );
+                    output_ph += __builtin_popcount( quarter_keep );
+                }
+                return output_ph;
+            }
+        };
+
+        //flattened, so that the whole loop is compiled for avx2 with the block operations inlined
+        __attribute__((target("avx2"), flatten))
+        std::size_t strip_avx2( char* data_ph, std::size_t size_p ) { return strip_blocks<avx2_block>( data_ph, size_p ); }
+
+        std::size_t strip_sse2( char* data_ph, std::size_t size_p ) { return strip_blocks<sse2_block>( data_ph, size_p ); }
+
+#endif
+
+        std::size_t strip_scalar( char* data_ph, std::size_t size_p ) { return strip_blocks<scalar_block>( data_ph, size_p ); }
+
+
+        struct implementation {
+            std::size_t (*strip)( char*, std::size_t );
+            char const* kind;
+        };
+
+        implementation const& selected() {
+            static implementation const result = [](){
+#ifdef IWIR_SCANNER_X86
+                __builtin_cpu_init();
+                if( __builtin_cpu_supports( "avx2" ) ){ return implementation{ strip_avx2, "avx2" }; }
+                if( __builtin_cpu_supports( "sse2" ) ){ return implementation{ strip_sse2, "sse2" }; }
+#endif
+                return implementation{ strip_scalar, "scalar" };
+            }();
+            return result;
+        }
+
+    } //namespace
+
+
+    std::size_t strip_whitespace( char* data_ph, std::size_t size_p ) { return selected().strip( data_ph, size_p ); }
+
+    char const* scanner_kind() { return selected().kind; }
+
+} //namespace iwir
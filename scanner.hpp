@@ -0,0 +1,38 @@
+//
+//File      : scanner.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef scanner_h
+#define scanner_h
+
+//std headers
+#include <cstddef>
+#include <string>
+
+
+namespace iwir {
+
+    //------------------------------scanner----------------------------------------
+    //first stage of the configurator: blocks of 16 or 32 bytes are classified at once, whitespace and
+    //the opening of user texts, and whatever is not whitespace is moved down in bulk
+    //the implementation is picked once, on the instruction sets of the running processor:
+    //avx2, sse2, or byte after byte when neither is available
+
+    //strips the whitespace of data_ph in place, user texts, [...], kept as they are
+    //returns the new size, a user text left open is stripped like the rest
+    std::size_t strip_whitespace( char* data_ph, std::size_t size_p );
+
+    inline void strip_whitespace( std::string& content_p ) {
+        if( content_p.empty() ){ return; }
+        content_p.resize( strip_whitespace( &content_p[0], content_p.size() ) );
+    }
+
+    //name of the implementation in use: "avx2", "sse2" or "scalar"
+    char const* scanner_kind();
+
+} //namespace iwir
+
+#endif /* scanner_h */
@@ -0,0 +1,134 @@
+//
+//File      : selector.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "selector.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+namespace iwir {
+
+    std::string glob_to_regex( std::string const& glob_p ) {
+        std::string result;
+        result.reserve( 2 * glob_p.size() );
+        for( auto c : glob_p ){
+            switch( c ){
+                case '*': result += ".*"; break;
+                case '?': result += '.'; break;
+                default:
+                    if( std::strchr( "\\^$.|+()[]{}", c ) ){ result += '\\'; }
+                    result += c;
+            }
+        }
+        return result;
+    }
+
+
+    //-------------------------selector_set---------------------------------------------
+
+    //out-of-line definitions, both being bound to references (resize, comparisons through std::pair)
+    constexpr int selector_set::no_match;
+    constexpr int selector_set::dead_state;
+
+    selector_set::selector_set( std::vector<std::string> const& pattern_pc ) : pattern_count_m{ pattern_pc.size() } {
+        std::vector<std::string> glob_c;
+        std::vector<int> index_c;
+        for( std::size_t i{0} ; i < pattern_pc.size() ; ++i ){
+            auto const& pattern = pattern_pc[i];
+            auto is_regex = pattern.size() > 1 && pattern.front() == '/' && pattern.back() == '/';
+            if( is_regex ){ regex_c.emplace_back( static_cast<int>( i ), std::regex{ pattern.substr( 1, pattern.size() - 2 ), std::regex::optimize } ); }
+            else{
+                glob_c.push_back( pattern );
+                index_c.push_back( static_cast<int>( i ) );
+            }
+        }
+        if( !glob_c.empty() ){ compile( glob_c, index_c ); }
+    }
+
+    //subset construction: a state of the automaton is the set of positions, (glob, character), reached so far
+    void selector_set::compile( std::vector<std::string> const& glob_pc, std::vector<int> const& index_pc ) {
+        for( auto const& glob : glob_pc ){
+            for( unsigned char c : glob ){
+                if( c != '*' && c != '?' && class_m[c] == 0 ){ class_m[c] = static_cast<uint8_t>( class_count_m++ ); }
+            }
+        }
+
+        using position = std::pair<std::size_t, std::size_t>;
+        auto close = [&glob_pc]( std::vector<position> position_p ){
+            //a star may match nothing, the position after it is reached as well
+            for( std::size_t i{0} ; i < position_p.size() ; ++i ){
+                auto const& glob = glob_pc[ position_p[i].first ];
+                auto const next = position_p[i].second;
+                if( next < glob.size() && glob[next] == '*' ){ position_p.emplace_back( position_p[i].first, next + 1 ); }
+            }
+            std::sort( position_p.begin(), position_p.end() );
+            position_p.erase( std::unique( position_p.begin(), position_p.end() ), position_p.end() );
+            return position_p;
+        };
+
+        std::map< std::vector<position>, int > state_mc;
+        std::vector< std::vector<position> > pending_c;
+        auto state_of = [this, &state_mc, &pending_c, &glob_pc, &index_pc]( std::vector<position> position_p ){
+            if( position_p.empty() ){ return dead_state; }
+            auto state_i = state_mc.find( position_p );
+            if( state_i != state_mc.end() ){ return state_i->second; }
+
+            int state = static_cast<int>( accepted_c.size() );
+            //positions are sorted by glob, the first one at its end is the first glob accepted
+            auto accepted = no_match;
+            for( auto const& current : position_p ){
+                if( current.second == glob_pc[ current.first ].size() ){ accepted = index_pc[ current.first ]; break; }
+            }
+            accepted_c.push_back( accepted );
+            transition_c.resize( transition_c.size() + class_count_m, dead_state );
+            state_mc.emplace( position_p, state );
+            pending_c.push_back( std::move(position_p) );
+            return state;
+        };
+
+        std::vector<position> start_c;
+        for( std::size_t i{0} ; i < glob_pc.size() ; ++i ){ start_c.emplace_back( i, 0 ); }
+        state_of( close( std::move(start_c) ) );
+
+        for( std::size_t state{0} ; state < pending_c.size() ; ++state ){
+            auto const current_c = pending_c[state];
+            for( std::size_t char_class{0} ; char_class < class_count_m ; ++char_class ){
+                std::vector<position> next_c;
+                for( auto const& current : current_c ){
+                    auto const& glob = glob_pc[ current.first ];
+                    if( current.second == glob.size() ){ continue; }
+                    unsigned char token = glob[ current.second ];
+                    if( token == '*' ){ next_c.push_back( current ); }
+                    else if( token == '?' || class_m[token] == char_class ){ next_c.emplace_back( current.first, current.second + 1 ); }
+                }
+                //built first: a new state grows transition_c, which would leave a reference taken beforehand dangling
+                auto const next_state = state_of( close( std::move(next_c) ) );
+                transition_c[ state * class_count_m + char_class ] = next_state;
+            }
+        }
+    }
+
+    int selector_set::match( std::string const& name_p ) const {
+        auto result = no_match;
+        if( !accepted_c.empty() ){
+            int state{0};
+            for( unsigned char c : name_p ){
+                state = transition_c[ state * class_count_m + class_m[c] ];
+                if( state == dead_state ){ break; }
+            }
+            if( state != dead_state ){ result = accepted_c[state]; }
+        }
+
+        for( auto const& regex : regex_c ){
+            if( result != no_match && regex.first > result ){ break; }
+            if( std::regex_match( name_p, regex.second ) ){ return regex.first; }
+        }
+        return result;
+    }
+
+} //namespace iwir
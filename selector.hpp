@@ -0,0 +1,59 @@
+//
+//File      : selector.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef selector_h
+#define selector_h
+
+//std headers
+#include <array>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <vector>
+
+
+namespace iwir {
+
+    //name patterns compiled together, so that each name is scanned once whatever the number of globs
+    //a pattern is either a glob (* and ?) or, between slashes, a regular expression: h_*_pt, /h_\d+/
+    //globs make a single deterministic automaton, one table lookup per character; regular expressions are tried
+    //one by one, and only those written before the first matching glob
+    //(written as a user_text in configurations, it cannot hold square brackets)
+    struct selector_set {
+        static constexpr int no_match = -1;
+
+    public:
+        explicit selector_set( std::vector<std::string> const& pattern_pc );
+
+        //index of the first pattern matching the whole name, no_match otherwise
+        int match( std::string const& name_p ) const;
+
+        bool empty() const { return pattern_count_m == 0; }
+
+    private:
+        void compile( std::vector<std::string> const& glob_pc, std::vector<int> const& index_pc );
+
+    private:
+        std::size_t pattern_count_m{0};
+
+        //characters written in some glob get a class each, all the others share class 0
+        std::array<uint8_t, 256> class_m{};
+        std::size_t class_count_m{1};
+        //state * class_count_m + class -> next state, dead_state once no glob can match any more
+        static constexpr int dead_state = -1;
+        std::vector<int> transition_c;
+        //first glob accepted in each state, no_match when none
+        std::vector<int> accepted_c;
+
+        std::vector< std::pair<int, std::regex> > regex_c;
+    };
+
+    std::string glob_to_regex( std::string const& glob_p );
+
+} //namespace iwir
+
+#endif /* selector_h */
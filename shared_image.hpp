@@ -0,0 +1,116 @@
+//
+//File      : shared_image.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef shared_image_h
+#define shared_image_h
+
+#include "configuration_image.hpp"
+
+#include <memory>
+#include <tuple>
+
+namespace iwir {
+
+    template<class Configuration> struct image_overlay;
+
+    //------------------------------shared_image----------------------------------------
+
+    //immutable, reference-counted image: every canvas styled from it reads the same storage
+    template<class Configuration>
+    struct shared_image {
+        using configuration_type = Configuration;
+
+    private:
+        //the image is copied into an arena owned by the shared state, so it does not depend on the one it was built in
+        struct storage {
+            explicit storage( image<Configuration> const& image_p ) : image_m{ copy_into( arena_m, image_p ) } {}
+
+            static image<Configuration> copy_into( monotonic_arena& arena_p, image<Configuration> const& image_p ){
+                arena_scope scope{ arena_p };
+                return image_p;
+            }
+
+            monotonic_arena arena_m{ 4 * 1024 };
+            image<Configuration> const image_m;
+        };
+
+    public:
+        explicit shared_image( image<Configuration> const& image_p ) :
+            storage_mh{ std::make_shared<storage const>( image_p ) } {}
+
+        template<class Element>
+        auto const& retrieve_element() const { return storage_mh->image_m.template retrieve_element<Element>(); }
+
+        std::string retrieve_content() const { return storage_mh->image_m.retrieve_content(); }
+
+        image_overlay<Configuration> make_overlay() const { return image_overlay<Configuration>{ storage_mh, storage_mh->image_m }; }
+
+    private:
+        std::shared_ptr<storage const> storage_mh;
+    };
+
+
+    //------------------------------image_overlay----------------------------------------
+
+    //per-canvas view of a shared image: an element is copied the first time it is modified, the others stay shared
+    template<class Configuration>
+    struct image_overlay {
+        using configuration_type = Configuration;
+        using element_tuple = typename image<Configuration>::element_tuple;
+
+    private:
+        template<class T> struct overlay_of;
+        template<class ... Ts>
+        struct overlay_of< std::tuple<Ts...> >{ using type = std::tuple< std::unique_ptr<Ts>... >; };
+        using overlay_tuple = typename overlay_of<element_tuple>::type;
+
+        template<class Element>
+        using element_type = typename element_traits<Element>::value_type;
+
+    public:
+        image_overlay( std::shared_ptr<void const> owner_ph, image<Configuration> const& base_p ) :
+            owner_mh{ std::move(owner_ph) }, base_mh{ &base_p } {}
+
+        template<class Element>
+        element_type<Element> const& retrieve_element() const {
+            auto const& overlay_h = std::get< std::unique_ptr< element_type<Element> > >( overlay_mc );
+            return overlay_h ? *overlay_h : base_mh->template retrieve_element<Element>();
+        }
+
+        template<class Element>
+        element_type<Element> & modify_element() {
+            auto & overlay_h = std::get< std::unique_ptr< element_type<Element> > >( overlay_mc );
+            if( !overlay_h ){
+                free_store_scope scope;
+                overlay_h.reset( new element_type<Element>{ base_mh->template retrieve_element<Element>() } );
+            }
+            return *overlay_h;
+        }
+
+        template<class Element>
+        bool is_overlaid() const { return bool( std::get< std::unique_ptr< element_type<Element> > >( overlay_mc ) ); }
+
+    private:
+        template<class ... Ts>
+        std::string retrieve_content_impl( std::tuple<Ts...> ) const {
+            return details::concatenate( retrieve_element<Ts>().retrieve_content()... );
+        }
+
+    public:
+        std::string retrieve_content() const {
+            return retrieve_content_impl( typename Configuration::elements{} );
+        }
+
+    private:
+        std::shared_ptr<void const> owner_mh;
+        image<Configuration> const* base_mh;
+        overlay_tuple overlay_mc;
+    };
+
+} //namespace iwir
+
+#endif /* shared_image_h */
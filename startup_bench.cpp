@@ -0,0 +1,64 @@
+//
+//File      : startup_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//cold start of a single apply, each run being a new process: the compiled iwir tool, found next to this bench,
+//against the interpreter loading the library as rootlogon.C does
+//usage: iwir-startup-bench <config> <root_file> <hist_1;hist_2;...> [run_count]
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+
+    //mean wall time of a run, negative when one failed
+    double measure( std::string const& command_p, unsigned run_count_p ) {
+        auto const start = std::chrono::steady_clock::now();
+        for( unsigned i{0} ; i < run_count_p ; ++i ){
+            if( std::system( command_p.c_str() ) != 0 ){
+                std::cerr << "Failed: " << command_p << "\n";
+                return -1;
+            }
+        }
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / run_count_p * 1e3;
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    if( argc < 4 ){
+        std::cerr << "usage: iwir-startup-bench <config> <root_file> <hist_1;hist_2;...> [run_count]\n";
+        return 1;
+    }
+    std::string const config_file{ argv[1] }, root_file{ argv[2] }, hist_list{ argv[3] };
+    unsigned const run_count = argc > 4 ? std::strtoul( argv[4], nullptr, 10 ) : 20;
+    if( !run_count ){ return 1; }
+
+    std::string const program{ argv[0] };
+    auto const slash = program.rfind( '/' );
+    auto const directory = slash == std::string::npos ? std::string{ "." } : program.substr( 0, slash );
+    std::string const output{ "iwir-startup-bench.png" };
+
+    auto const compiled = measure( "'" + directory + "/iwir' apply '" + config_file + "' '" + root_file + "' '" + hist_list +
+                                   "' " + output + " > /dev/null", run_count );
+    auto const interpreted = measure( "root -l -b -q -e 'gSystem->Load(\"libiwir\");' "
+                                      "-e 'TFile::Open(\"" + root_file + "\");' "
+                                      "-e 'apply_configuration(\"" + config_file + "\", \"" + hist_list + "\");' "
+                                      "-e 'gPad->SaveAs(\"" + output + "\");' > /dev/null", run_count );
+    std::remove( output.c_str() );
+    if( compiled < 0 || interpreted < 0 ){ return 1; }
+
+    std::cout << "iwir apply: " << compiled << " ms per run\n"
+              << "root -e apply_configuration: " << interpreted << " ms per run ("
+              << ( compiled > 0 ? interpreted / compiled : 0. ) << " times slower)\n";
+    return 0;
+}
@@ -0,0 +1,205 @@
+//
+//File      : stream_renderer.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "stream_renderer.hpp"
+#include "configurator.hpp"
+#include "key_index.hpp"
+#include "root_context.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <thread>
+#include <vector>
+
+#include "TClass.h"
+#include "TFile.h"
+#include "TROOT.h"
+
+namespace iwir {
+
+    namespace {
+        struct window {
+            std::vector< std::vector<TH1D*> > plot_c;
+            std::vector< std::string > name_c;
+        };
+
+        //single slot between the reader and the renderer: the reader only starts on a window once the previous one
+        //has been taken, so that no more than two windows are ever resident
+        struct window_channel {
+            void wait_empty() {
+                std::unique_lock<std::mutex> lock{ mutex };
+                condition.wait( lock, [this](){ return !full; } );
+            }
+
+            void push( window window_p ) {
+                std::lock_guard<std::mutex> lock{ mutex };
+                slot = std::move(window_p);
+                full = true;
+                condition.notify_all();
+            }
+
+            void close() {
+                std::lock_guard<std::mutex> lock{ mutex };
+                closed = true;
+                condition.notify_all();
+            }
+
+            bool pop( window& window_p ) {
+                std::unique_lock<std::mutex> lock{ mutex };
+                condition.wait( lock, [this](){ return full || closed; } );
+                if( !full ){ return false; }
+                window_p = std::move(slot);
+                full = false;
+                condition.notify_all();
+                return true;
+            }
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            window slot;
+            bool full{false};
+            bool closed{false};
+        };
+
+        std::string output_name( std::string pattern_p, std::string path_p ) {
+            std::replace( path_p.begin(), path_p.end(), '/', '_' );
+
+            auto position = pattern_p.find( "{}" );
+            if( position != std::string::npos ){ return pattern_p.replace( position, 2, path_p ); }
+
+            auto dot = pattern_p.rfind( '.' );
+            auto slash = pattern_p.rfind( '/' );
+            if( dot == std::string::npos || ( slash != std::string::npos && dot < slash ) ){ return pattern_p + '_' + path_p; }
+            return pattern_p.insert( dot, '_' + path_p );
+        }
+
+        std::vector<key_entry> select( std::string const& root_file_p, std::string const& pattern_p ) {
+            std::vector<key_entry> result_c;
+
+            std::unique_ptr<TFile> file_h{ TFile::Open( root_file_p.c_str() ) };
+            if( !file_h || file_h->IsZombie() ){
+                std::cerr << "Could not open file: " << root_file_p << "\n";
+                return result_c;
+            }
+
+            std::regex pattern{ pattern_p };
+            auto const index_h = key_index::of( file_h.get() );
+            for( auto const& entry : index_h->entries() ){
+                auto * class_h = TClass::GetClass( entry.class_name.c_str() );
+                if( class_h && class_h->InheritsFrom( TH1D::Class() ) && std::regex_match( entry.path, pattern ) ){
+                    result_c.push_back( entry );
+                }
+            }
+
+            //reading in file order keeps the accesses sequential
+            std::sort( result_c.begin(), result_c.end(),
+                       []( key_entry const& lhs_p, key_entry const& rhs_p ){ return lhs_p.seek < rhs_p.seek; } );
+            return result_c;
+        }
+    } //namespace
+
+
+    stream_renderer::stream_renderer( std::size_t budget_bytes_p, std::size_t hist_per_plot_p ) :
+        budget_m{ budget_bytes_p }, hist_per_plot_m{ std::max<std::size_t>( 1, hist_per_plot_p ) } {}
+
+
+    stream_renderer::report stream_renderer::operator()( std::string const& config_file_p,
+                                                         std::string const& root_file_p,
+                                                         std::string const& pattern_p,
+                                                         std::string const& output_pattern_p ) const {
+        report result;
+
+        auto applier = configurator{}.prepare( config_file_p );
+        if( !applier ){ return result; }
+
+        auto const entry_c = select( root_file_p, pattern_p );
+        if( entry_c.empty() ){ return result; }
+
+        //windows are cut between plots, from the uncompressed size of the objects
+        std::vector<std::size_t> window_first_c{ 0 };
+        std::vector<std::size_t> window_bytes_c{ 0 };
+        for( std::size_t first{0} ; first < entry_c.size() ; first += hist_per_plot_m ){
+            auto last = std::min( first + hist_per_plot_m, entry_c.size() );
+            std::size_t plot_bytes{0};
+            for( auto index = first ; index < last ; ++index ){ plot_bytes += entry_c[index].object_length; }
+
+            if( first != window_first_c.back() && window_bytes_c.back() + plot_bytes > budget_m / 2 ){
+                window_first_c.push_back( first );
+                window_bytes_c.push_back( 0 );
+            }
+            window_bytes_c.back() += plot_bytes;
+        }
+        window_first_c.push_back( entry_c.size() );
+
+        result.window_count = window_bytes_c.size();
+        result.peak_bytes = window_bytes_c.front();
+        for( std::size_t i{1} ; i < window_bytes_c.size() ; ++i ){
+            result.peak_bytes = std::max( result.peak_bytes, window_bytes_c[i-1] + window_bytes_c[i] );
+        }
+
+        ROOT::EnableThreadSafety();
+        auto was_batch = gROOT->IsBatch();
+        gROOT->SetBatch( true );
+        auto start = std::chrono::steady_clock::now();
+
+        window_channel channel;
+        std::thread reader{ [&](){
+            auto file_h = open_private( root_file_p );
+            for( std::size_t w{0} ; file_h && w + 1 < window_first_c.size() ; ++w ){
+                channel.wait_empty();
+
+                window current;
+                for( auto first = window_first_c[w] ; first < window_first_c[w+1] ; first += hist_per_plot_m ){
+                    auto last = std::min( first + hist_per_plot_m, window_first_c[w+1] );
+
+                    std::vector<TH1D*> hist_c;
+                    for( auto index = first ; index < last ; ++index ){
+                        auto * hist_h = dynamic_cast<TH1D*>( read_object( file_h.get(), entry_c[index] ) );
+                        if( !hist_h ){ continue; }
+                        //detached, the reader file is closed before the histograms are drawn
+                        hist_h->SetDirectory( nullptr );
+                        hist_c.push_back( hist_h );
+                    }
+                    current.plot_c.push_back( std::move(hist_c) );
+                    current.name_c.push_back( entry_c[first].path );
+                }
+                channel.push( std::move(current) );
+            }
+            channel.close();
+        } };
+
+        window current;
+        while( channel.pop( current ) ){
+            for( std::size_t i{0} ; i < current.plot_c.size() ; ++i ){
+                auto& hist_c = current.plot_c[i];
+                if( hist_c.empty() ){ continue; }
+
+                auto read_c = hist_c;
+                auto * canvas_h = applier( std::move(hist_c) );
+                canvas_h->SaveAs( output_name( output_pattern_p, current.name_c[i] ).c_str() );
+
+                delete canvas_h;
+                for( auto * read_h : read_c ){ delete read_h; }
+                ++result.rendered;
+            }
+        }
+        reader.join();
+
+        result.seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+        gROOT->SetBatch( was_batch );
+
+        std::cout << "streamed: " << result.rendered << " plots in " << result.window_count << " windows, "
+                  << result.seconds << "s, at most " << (result.peak_bytes >> 20) << "MB resident\n";
+        return result;
+    }
+
+} //namespace iwir
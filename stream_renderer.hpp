@@ -0,0 +1,48 @@
+//
+//File      : stream_renderer.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef stream_renderer_h
+#define stream_renderer_h
+
+//std headers
+#include <string>
+
+
+namespace iwir {
+
+    //renders every TH1D of a file whose path matches a pattern without ever holding them all:
+    //histograms are read, drawn, exported and deleted window by window, the next window being read
+    //by a background thread (through its own TFile) while the current one is drawn
+    struct stream_renderer {
+        struct report {
+            std::size_t rendered{0};
+            std::size_t window_count{0};
+            std::size_t peak_bytes{0};
+            double seconds{0};
+        };
+
+    public:
+        //at most two windows are resident at once, each one is given half of budget_bytes_p
+        //(a window always holds at least one plot, whatever its size)
+        explicit stream_renderer( std::size_t budget_bytes_p = std::size_t{256} << 20,
+                                  std::size_t hist_per_plot_p = 1 );
+
+        //{} in output_pattern_p is replaced by the path of the first histogram of each plot ('/' becoming '_'),
+        //it is inserted before the extension otherwise
+        report operator()( std::string const& config_file_p,
+                           std::string const& root_file_p,
+                           std::string const& pattern_p,
+                           std::string const& output_pattern_p ) const;
+
+    private:
+        std::size_t budget_m;
+        std::size_t hist_per_plot_m;
+    };
+
+} //namespace iwir
+
+#endif /* stream_renderer_h */
@@ -0,0 +1,111 @@
+//
+//File      : stress_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//save and apply from several threads at once: each one draws its own canvas, saves it, resets its histogram, reads
+//the configuration back and applies it, then checks that the canvas drawn gave the histogram its style back
+//usage: iwir-stress-bench [thread_count] [iteration_count] [directory]
+
+
+#include "saver.hpp"
+#include "configurator.hpp"
+#include "root_context.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TCanvas.h"
+#include "TH1.h"
+#include "TROOT.h"
+
+namespace {
+
+    struct counter {
+        std::atomic<std::size_t> done{0};
+        std::atomic<std::size_t> failed{0};
+    };
+
+    void work( unsigned thread_p, unsigned iteration_count_p, std::string const& directory_p, counter& counter_p ) {
+        for( unsigned i{0} ; i < iteration_count_p ; ++i ){
+            auto const tag = "stress_" + std::to_string( thread_p ) + "_" + std::to_string( i );
+            auto const config_file = directory_p + "/" + tag + ".config";
+
+            TCanvas* canvas_h{nullptr};
+            TH1D* hist_h{nullptr};
+            {
+                //canvas creation and drawing go through ROOT global state
+                iwir::root_guard guard{ iwir::root_mutex() };
+                canvas_h = new TCanvas{ ( "c_" + tag ).c_str(), "", 400, 300 };
+                hist_h = new TH1D{ ( "h_" + tag ).c_str(), "", 10, 0, 1 };
+                hist_h->GetXaxis()->SetTitle( tag.c_str() );
+                hist_h->SetLineColor( 1 + thread_p % 50 );
+                hist_h->Draw();
+            }
+
+            iwir::saver{}( canvas_h, config_file );
+            iwir::saver::flush();
+            {
+                iwir::root_guard guard{ iwir::root_mutex() };
+                delete canvas_h;
+                hist_h->SetLineColor( 0 );
+            }
+
+            //looked for among the in-memory objects only, by the name only this thread uses
+            iwir::configurator{}( config_file, hist_h->GetName(), iwir::lookup_context{ gROOT, {} } );
+
+            {
+                iwir::root_guard guard{ iwir::root_mutex() };
+                TCanvas* applied_h{nullptr};
+                for( auto * object_h : *gROOT->GetListOfCanvases() ){
+                    auto * candidate_h = static_cast<TCanvas*>( object_h );
+                    if( candidate_h->GetListOfPrimitives()->FindObject( hist_h ) ){ applied_h = candidate_h; break; }
+                }
+                if( !applied_h || hist_h->GetLineColor() != static_cast<Color_t>( 1 + thread_p % 50 ) ){
+                    std::cerr << "Configuration not applied back: " << config_file << "\n";
+                    ++counter_p.failed;
+                }
+                delete applied_h;
+                delete hist_h;
+            }
+            ++counter_p.done;
+        }
+    }
+
+} //namespace
+
+
+int main( int argc, char* argv[] ) {
+    unsigned const thread_count = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : std::thread::hardware_concurrency();
+    unsigned const iteration_count = argc > 2 ? std::strtoul( argv[2], nullptr, 10 ) : 100;
+    std::string const directory = argc > 3 ? argv[3] : ".";
+    if( !thread_count || !iteration_count ){
+        std::cerr << "usage: iwir-stress-bench [thread_count] [iteration_count] [directory]\n";
+        return 1;
+    }
+
+    ROOT::EnableThreadSafety();
+    gROOT->SetBatch( true );
+
+    counter counter;
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> thread_c;
+    for( unsigned i{0} ; i < thread_count ; ++i ){
+        thread_c.emplace_back( work, i, iteration_count, std::cref( directory ), std::ref( counter ) );
+    }
+    for( auto& thread : thread_c ){ thread.join(); }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "threads: " << thread_count << ", saved and applied: " << counter.done << " in " << elapsed.count() << "s ("
+              << ( elapsed.count() > 0 ? counter.done / elapsed.count() : 0. ) << " per second), "
+              << counter.failed << " failures\n";
+    return counter.failed ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+//
+//File      : style_bench.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+//throughput of the style-only apply on histograms built in memory, no canvas being created at any point
+//usage: iwir-style-bench <config> [hist_count] [repetition_count]
+
+
+#include "configurator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "TH1.h"
+
+int main( int argc, char* argv[] ) {
+    if( argc < 2 ){
+        std::cerr << "usage: iwir-style-bench <config> [hist_count] [repetition_count]\n";
+        return 1;
+    }
+    std::string const config_file{ argv[1] };
+    std::size_t const hist_count = argc > 2 ? std::strtoul( argv[2], nullptr, 10 ) : 1000000;
+    unsigned const repetition_count = argc > 3 ? std::strtoul( argv[3], nullptr, 10 ) : 5;
+    if( !hist_count || !repetition_count ){ return 1; }
+
+    auto const styler = iwir::configurator{}.prepare_style( config_file );
+    if( !styler ){ return 1; }
+
+    //kept out of gDirectory: a million names in its list would be measured as well
+    TH1::AddDirectory( false );
+    std::vector< std::unique_ptr<TH1D> > owner_c;
+    std::vector<TH1*> hist_c;
+    owner_c.reserve( hist_count );
+    hist_c.reserve( hist_count );
+    for( std::size_t i{0} ; i < hist_count ; ++i ){
+        owner_c.emplace_back( new TH1D{ ( "h_" + std::to_string( i ) ).c_str(), "", 10, 0, 1 } );
+        hist_c.push_back( owner_c.back().get() );
+    }
+
+    double best{0};
+    for( unsigned i{0} ; i < repetition_count ; ++i ){
+        auto const start = std::chrono::steady_clock::now();
+        styler( hist_c, 0 );
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+        best = std::max( best, elapsed.count() > 0 ? hist_count / elapsed.count() * 60 : 0. );
+    }
+
+    std::cout << "styled: " << hist_count << " histograms, " << best * 1e-6 << " million histograms per minute\n";
+    return 0;
+}
@@ -0,0 +1,225 @@
+//
+//File      : watcher.cpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#include "watcher.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "TFileHandler.h"
+#include "TSystem.h"
+#include "TTimer.h"
+
+namespace iwir {
+
+    namespace {
+        //editors save in several steps (truncate and write, or write aside and rename), the last one closing the burst
+        constexpr long coalescing_delay_ms = 150;
+        
+        //directory resolved, so that the path matches the one rebuilt from an event whichever way it was spelled
+        //the file itself is not resolved: it may be replaced by another one on each save
+        std::pair<std::string, std::string> split_path( std::string const& path_p ){
+            auto const separator = path_p.find_last_of('/');
+            std::string directory = separator == std::string::npos ? "." : path_p.substr( 0, separator );
+            if( directory.empty() ){ directory = "/"; }
+            
+            char resolved[PATH_MAX];
+            if( !::realpath( directory.c_str(), resolved ) ){ return {}; }
+            return { resolved, path_p.substr( separator == std::string::npos ? 0 : separator + 1 ) };
+        }
+        
+        //file holding the configuration: the bundle for <bundle>#<entry> (see bundle.hpp), as read_file tells them apart
+        std::pair<std::string, std::string> split_entry( std::string const& config_file_p ){
+            auto const separator = config_file_p.rfind( '#' );
+            if( separator == std::string::npos || std::ifstream{ config_file_p }.is_open() ){ return { config_file_p, {} }; }
+            return { config_file_p.substr( 0, separator ), config_file_p.substr( separator ) };
+        }
+        
+        //the index of a bundle is renamed into place after the bundle itself, either of them tells it changed
+        std::string const index_suffix = ".iwir-index";
+    }
+    
+    
+    struct config_watcher::event_handler : TFileHandler {
+        event_handler( int descriptor_p, config_watcher& watcher_p ) :
+            TFileHandler{ descriptor_p, TFileHandler::kRead }, watcher_m{ watcher_p } {}
+        
+        Bool_t Notify() override {
+#ifdef __linux__
+            //the descriptor is non blocking: everything queued is drained at once
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while( (length = ::read( GetFd(), buffer, sizeof(buffer) )) > 0 ){
+                for( auto * event_i = buffer ; event_i < buffer + length ; ){
+                    auto const * event_h = reinterpret_cast<inotify_event const*>( event_i );
+                    if( event_h->len > 0 ){ watcher_m.notify( event_h->wd, event_h->name ); }
+                    event_i += sizeof(inotify_event) + event_h->len;
+                }
+            }
+#endif
+            return kTRUE;
+        }
+        
+    private:
+        config_watcher& watcher_m;
+    };
+    
+    struct config_watcher::coalescing_timer : TTimer {
+        explicit coalescing_timer( config_watcher& watcher_p ) :
+            TTimer{ coalescing_delay_ms, kTRUE }, watcher_m{ watcher_p } {}
+        
+        Bool_t Notify() override {
+            TurnOff();
+            watcher_m.reload();
+            return kTRUE;
+        }
+        
+    private:
+        config_watcher& watcher_m;
+    };
+    
+    
+    //never destroyed: handler and timer would otherwise be removed from a system ROOT may already have torn down
+    config_watcher& config_watcher::instance() {
+        static auto * watcher = new config_watcher{};
+        return *watcher;
+    }
+    
+    config_watcher::config_watcher() {
+#ifdef __linux__
+        descriptor_m = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+        if( descriptor_m < 0 ){
+            std::cerr << "Could not initialize inotify, configurations will not be reloaded\n";
+            return;
+        }
+        handler_mh.reset( new event_handler{ descriptor_m, *this } );
+        gSystem->AddFileHandler( handler_mh.get() );
+        timer_mh.reset( new coalescing_timer{ *this } );
+#else
+        std::cerr << "Configurations are only reloaded on linux\n";
+#endif
+    }
+    
+    config_watcher::~config_watcher() {
+#ifdef __linux__
+        if( descriptor_m < 0 ){ return; }
+        timer_mh->TurnOff();
+        gSystem->RemoveFileHandler( handler_mh.get() );
+        ::close( descriptor_m );
+#endif
+    }
+    
+    
+    TCanvas* config_watcher::watch( std::string const& config_file_p, std::string const& hist_list_p ) {
+        auto const entry = split_entry( config_file_p );
+        auto const location = split_path( entry.first );
+        if( location.first.empty() ){
+            std::cerr << "Could not find directory of: " << config_file_p << '\n';
+            return nullptr;
+        }
+        auto const file = location.first + '/' + location.second;
+        auto const path = file + entry.second;
+        
+        auto * canvas_h = applier_m( path, hist_list_p );
+        if( !canvas_h ){ return nullptr; }
+        
+        auto config_i = config_mc.find( hist_list_p );
+        if( config_i != config_mc.end() && config_i->second != path ){ hist_list_mc[ config_i->second ].erase( hist_list_p ); }
+        config_mc[ hist_list_p ] = path;
+        hist_list_mc[ path ].insert( hist_list_p );
+        config_file_mc[ file ].insert( path );
+        
+        add_directory( location.first );
+        return canvas_h;
+    }
+    
+    void config_watcher::unwatch( std::string const& hist_list_p ) {
+        auto config_i = config_mc.find( hist_list_p );
+        if( config_i == config_mc.end() ){ return; }
+        
+        auto hist_list_i = hist_list_mc.find( config_i->second );
+        hist_list_i->second.erase( hist_list_p );
+        if( hist_list_i->second.empty() ){
+            //the file is not split again: it may have been removed since
+            for( auto config_file_i = config_file_mc.begin() ; config_file_i != config_file_mc.end() ; ){
+                config_file_i->second.erase( config_i->second );
+                if( config_file_i->second.empty() ){ config_file_i = config_file_mc.erase( config_file_i ); }
+                else{ ++config_file_i; }
+            }
+            hist_list_mc.erase( hist_list_i );
+        }
+        
+        config_mc.erase( config_i );
+        applier_m.forget( hist_list_p );
+    }
+    
+    
+    bool config_watcher::add_directory( std::string const& directory_p ) {
+#ifdef __linux__
+        if( descriptor_m < 0 ){ return false; }
+        
+        //the same descriptor is given back for a directory already watched
+        auto const watch_descriptor = inotify_add_watch( descriptor_m, directory_p.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO );
+        if( watch_descriptor < 0 ){
+            std::cerr << "Could not watch directory: " << directory_p << '\n';
+            return false;
+        }
+        directory_mc[ watch_descriptor ] = directory_p;
+        return true;
+#else
+        return false;
+#endif
+    }
+    
+    void config_watcher::notify( int watch_descriptor_p, std::string const& file_name_p ) {
+        auto directory_i = directory_mc.find( watch_descriptor_p );
+        if( directory_i == directory_mc.end() ){ return; }
+        
+        auto file = directory_i->second + '/' + file_name_p;
+        auto config_file_i = config_file_mc.find( file );
+        if( config_file_i == config_file_mc.end() && file.size() > index_suffix.size() &&
+            file.compare( file.size() - index_suffix.size(), index_suffix.size(), index_suffix ) == 0 ){
+            config_file_i = config_file_mc.find( file.substr( 0, file.size() - index_suffix.size() ) );
+        }
+        if( config_file_i == config_file_mc.end() ){ return; }
+        
+        //every watched entry of a bundle, whether its own content changed or not: unchanged ones are left as they are
+        changed_mc.insert( config_file_i->second.begin(), config_file_i->second.end() );
+        //restarted by every event of the burst
+        timer_mh->Start( coalescing_delay_ms, kTRUE );
+    }
+    
+    
+    std::size_t config_watcher::reload() {
+        auto changed_c = std::move( changed_mc );
+        changed_mc.clear();
+        
+        std::size_t updated{0};
+        for( auto const& path : changed_c ){
+            auto hist_list_i = hist_list_mc.find( path );
+            if( hist_list_i == hist_list_mc.end() ){ continue; }
+            
+            //copied, closed canvases being unwatched on the way
+            std::vector<std::string> const hist_list_c{ hist_list_i->second.begin(), hist_list_i->second.end() };
+            auto const parsed_h = configurator{}.parse( path );
+            for( auto const& hist_list : hist_list_c ){
+                if( !applier_m.canvas( hist_list ) ){ unwatch( hist_list ); continue; }
+                if( applier_m( path, hist_list, parsed_h.get() ) ){ ++updated; }
+            }
+        }
+        return updated;
+    }
+
+} //namespace iwir
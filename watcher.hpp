@@ -0,0 +1,77 @@
+//
+//File      : watcher.hpp
+//Author    : Alexandre Sécher (alexandre.secher@iphc.cnrs.fr)
+//Date      : 19/10/2026
+//Framework : PhD thesis, CNRS/IPHC/DRS/DeSis, Strasbourg, France
+//
+
+#ifndef watcher_h
+#define watcher_h
+
+//iwir header
+#include "incremental.hpp"
+
+
+//std headers
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+
+//ROOT header
+#include "TCanvas.h"
+
+
+class TFileHandler;
+class TTimer;
+
+namespace iwir {
+
+    //canvases kept in sync with the configuration files they were drawn from, for the length of an interactive session:
+    //a single inotify descriptor, watching the directories of the files, is polled by the ROOT event loop
+    //the bursts of events an editor produces when saving are coalesced by a timer, restarted by each of them,
+    //after which every changed file is parsed once, the image updating each of its canvases incrementally (see
+    //incremental.hpp); only canvases drawn again from scratch, on a structural change, read the file again
+    //nothing runs between saves, linux only: elsewhere canvases are drawn but never reloaded
+    struct config_watcher {
+        static config_watcher& instance();
+        
+        //draws the canvas and reloads it whenever config_file_p is saved, until unwatch or until the canvas is closed
+        TCanvas* watch( std::string const& config_file_p, std::string const& hist_list_p );
+        void unwatch( std::string const& hist_list_p );
+        
+        //updates the canvases of every file changed since the last call, returns how many were
+        std::size_t reload();
+        
+        std::size_t size() const { return config_mc.size(); }
+        
+    private:
+        config_watcher();
+        ~config_watcher();
+        
+        struct event_handler;
+        struct coalescing_timer;
+        
+        //called by the handler, for each file written or moved into a watched directory
+        //a bundle, or its index, stands for every watched <bundle>#<entry>
+        void notify( int watch_descriptor_p, std::string const& file_name_p );
+        bool add_directory( std::string const& directory_p );
+        
+    private:
+        int descriptor_m{-1};
+        std::unique_ptr<event_handler> handler_mh;
+        std::unique_ptr<coalescing_timer> timer_mh;
+        
+        std::unordered_map< int, std::string > directory_mc;                      //watch descriptor -> directory
+        std::unordered_map< std::string, std::set<std::string> > hist_list_mc;  //configuration -> lists drawn from it
+        std::unordered_map< std::string, std::string > config_mc;               //list -> configuration
+        std::unordered_map< std::string, std::set<std::string> > config_file_mc; //file -> configurations read from it
+        std::set<std::string> changed_mc;
+        
+        incremental_applier applier_m;
+    };
+
+} //namespace iwir
+
+#endif /* watcher_h */